@@ -0,0 +1,97 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock-free histogram of durations with power-of-two microsecond buckets.
+ *
+ * Bucket 0 holds durations below 1 us, bucket i holds [2^(i-1), 2^i) us and the last
+ * bucket collects everything above. Recording is wait-free and may happen on any thread.
+ */
+class LatencyHistogram {
+public:
+  static constexpr std::size_t kBucketCount = 26;
+
+  void Record(std::chrono::nanoseconds duration) {
+    const auto us = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0) / 1000);
+    const std::size_t bucket = std::min<std::size_t>(std::bit_width(us), kBucketCount - 1);
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::uint64_t GetCount() const {
+    std::uint64_t count = 0;
+    for (const auto& bucket : buckets_) {
+      count += bucket.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+  std::uint64_t GetBucketCount(std::size_t bucket) const {
+    return buckets_[bucket].load(std::memory_order_relaxed);
+  }
+
+  // Exclusive upper bound of a bucket in microseconds.
+  static constexpr std::uint64_t GetBucketUpperBoundUs(std::size_t bucket) {
+    return std::uint64_t{1} << bucket;
+  }
+
+  /**
+   * @brief Gets an upper bound for the given percentile
+   * @param percentile Value in [0, 1]
+   * @return Upper bound of the bucket containing the percentile in microseconds, 0 if nothing was recorded
+   */
+  std::uint64_t GetPercentileUs(double percentile) const {
+    const std::uint64_t count = GetCount();
+    if (count == 0) {
+      return 0;
+    }
+    const auto rank = static_cast<std::uint64_t>(percentile * static_cast<double>(count - 1));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+      seen += buckets_[bucket].load(std::memory_order_relaxed);
+      if (seen > rank) {
+        return GetBucketUpperBoundUs(bucket);
+      }
+    }
+    return GetBucketUpperBoundUs(kBucketCount - 1);
+  }
+
+  void Reset() {
+    for (auto& bucket : buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+};
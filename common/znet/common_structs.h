@@ -27,12 +27,18 @@ SOFTWARE.
 
 #include <fmt/ostream.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <ostream>
 #include <string>
 
+#include "quantization.h"
+
 using PlayerID = std::uint32_t;
+// Compact player id used in packets instead of the PlayerID, assigned by the server for the length of a session.
+// 0 is never assigned, and the ids of players who left are only reused after a quarantine period.
+using NetId = std::uint16_t;
 
 struct PlayerState {
   glm::vec3 position{0.0f};
@@ -50,21 +56,135 @@ struct PlayerState {
   std::int16_t ranged_weapon_instance{0};
 };
 
+// Bit flags identifying the fields of PlayerState, used by delta-compressed snapshots.
+enum PlayerStateField : std::uint16_t {
+  PSF_POSITION = 1 << 0,
+  PSF_NROT = 1 << 1,
+  PSF_LEFT_HAND_ITEM = 1 << 2,
+  PSF_RIGHT_HAND_ITEM = 1 << 3,
+  PSF_EQUIPPED_ARMOR = 1 << 4,
+  PSF_ANIMATION = 1 << 5,
+  PSF_HEALTH_POINTS = 1 << 6,
+  PSF_MANA_POINTS = 1 << 7,
+  PSF_WEAPON_MODE = 1 << 8,
+  PSF_ACTIVE_SPELL = 1 << 9,
+  PSF_HEAD_DIRECTION = 1 << 10,
+  PSF_MELEE_WEAPON = 1 << 11,
+  PSF_RANGED_WEAPON = 1 << 12,
+};
+
+constexpr std::uint16_t kAllPlayerStateFields = (1 << 13) - 1;
+
+// Number of snapshots a delta may reach back for its baseline. Both sides keep this many past states per player.
+constexpr std::uint16_t kSnapshotBaselineWindow = 32;
+
+// Returns the fields in which `state` differs from `baseline`.
+inline std::uint16_t GetChangedPlayerStateFields(const PlayerState& baseline, const PlayerState& state) {
+  std::uint16_t fields = 0;
+  fields |= baseline.position != state.position ? PSF_POSITION : 0;
+  fields |= baseline.nrot != state.nrot ? PSF_NROT : 0;
+  fields |= baseline.left_hand_item_instance != state.left_hand_item_instance ? PSF_LEFT_HAND_ITEM : 0;
+  fields |= baseline.right_hand_item_instance != state.right_hand_item_instance ? PSF_RIGHT_HAND_ITEM : 0;
+  fields |= baseline.equipped_armor_instance != state.equipped_armor_instance ? PSF_EQUIPPED_ARMOR : 0;
+  fields |= baseline.animation != state.animation ? PSF_ANIMATION : 0;
+  fields |= baseline.health_points != state.health_points ? PSF_HEALTH_POINTS : 0;
+  fields |= baseline.mana_points != state.mana_points ? PSF_MANA_POINTS : 0;
+  fields |= baseline.weapon_mode != state.weapon_mode ? PSF_WEAPON_MODE : 0;
+  fields |= baseline.active_spell_nr != state.active_spell_nr ? PSF_ACTIVE_SPELL : 0;
+  fields |= baseline.head_direction != state.head_direction ? PSF_HEAD_DIRECTION : 0;
+  fields |= baseline.melee_weapon_instance != state.melee_weapon_instance ? PSF_MELEE_WEAPON : 0;
+  fields |= baseline.ranged_weapon_instance != state.ranged_weapon_instance ? PSF_RANGED_WEAPON : 0;
+  return fields;
+}
+
+// Copies the selected fields from `source` into `destination`.
+inline void CopyPlayerStateFields(const PlayerState& source, PlayerState& destination, std::uint16_t fields) {
+  if (fields & PSF_POSITION)
+    destination.position = source.position;
+  if (fields & PSF_NROT)
+    destination.nrot = source.nrot;
+  if (fields & PSF_LEFT_HAND_ITEM)
+    destination.left_hand_item_instance = source.left_hand_item_instance;
+  if (fields & PSF_RIGHT_HAND_ITEM)
+    destination.right_hand_item_instance = source.right_hand_item_instance;
+  if (fields & PSF_EQUIPPED_ARMOR)
+    destination.equipped_armor_instance = source.equipped_armor_instance;
+  if (fields & PSF_ANIMATION)
+    destination.animation = source.animation;
+  if (fields & PSF_HEALTH_POINTS)
+    destination.health_points = source.health_points;
+  if (fields & PSF_MANA_POINTS)
+    destination.mana_points = source.mana_points;
+  if (fields & PSF_WEAPON_MODE)
+    destination.weapon_mode = source.weapon_mode;
+  if (fields & PSF_ACTIVE_SPELL)
+    destination.active_spell_nr = source.active_spell_nr;
+  if (fields & PSF_HEAD_DIRECTION)
+    destination.head_direction = source.head_direction;
+  if (fields & PSF_MELEE_WEAPON)
+    destination.melee_weapon_instance = source.melee_weapon_instance;
+  if (fields & PSF_RANGED_WEAPON)
+    destination.ranged_weapon_instance = source.ranged_weapon_instance;
+}
+
+// Serializes only the selected fields, in declaration order. Positions, rotations and the small enums are quantized.
+template <typename S>
+void SerializePlayerStateFields(S& s, PlayerState& packet, std::uint16_t fields) {
+  s.enableBitPacking([&packet, fields](typename S::BPEnabledType& sbp) {
+    if (fields & PSF_POSITION)
+      sbp.ext(packet.position, Net::QuantizedPosition{});
+    if (fields & PSF_NROT)
+      sbp.ext(packet.nrot, Net::QuantizedNormal{});
+    if (fields & PSF_LEFT_HAND_ITEM)
+      sbp.value2b(packet.left_hand_item_instance);
+    if (fields & PSF_RIGHT_HAND_ITEM)
+      sbp.value2b(packet.right_hand_item_instance);
+    if (fields & PSF_EQUIPPED_ARMOR)
+      sbp.value2b(packet.equipped_armor_instance);
+    if (fields & PSF_ANIMATION)
+      sbp.value2b(packet.animation);
+    if (fields & PSF_HEALTH_POINTS)
+      sbp.value2b(packet.health_points);
+    if (fields & PSF_MANA_POINTS)
+      sbp.value2b(packet.mana_points);
+    if (fields & PSF_WEAPON_MODE)
+      sbp.ext(packet.weapon_mode, Net::WeaponModeBits{});
+    if (fields & PSF_ACTIVE_SPELL)
+      sbp.ext(packet.active_spell_nr, Net::SpellNrBits{});
+    if (fields & PSF_HEAD_DIRECTION)
+      sbp.ext(packet.head_direction, Net::HeadDirectionBits{});
+    if (fields & PSF_MELEE_WEAPON)
+      sbp.value2b(packet.melee_weapon_instance);
+    if (fields & PSF_RANGED_WEAPON)
+      sbp.value2b(packet.ranged_weapon_instance);
+  });
+}
+
+// Bytes SerializePlayerStateFields writes for the selected fields. The bit-packed fields are padded to a whole byte.
+constexpr std::size_t GetPlayerStateFieldsSize(std::uint16_t fields) {
+  constexpr std::uint16_t kTwoByteFields = PSF_LEFT_HAND_ITEM | PSF_RIGHT_HAND_ITEM | PSF_EQUIPPED_ARMOR | PSF_ANIMATION | PSF_HEALTH_POINTS |
+                                           PSF_MANA_POINTS | PSF_MELEE_WEAPON | PSF_RANGED_WEAPON;
+  std::size_t bits = 0;
+  if (fields & PSF_POSITION)
+    bits += 2 * Net::kHorizontalPositionBits + Net::kVerticalPositionBits;
+  if (fields & PSF_NROT)
+    bits += 2 * Net::kNormalComponentBits;
+  for (std::uint16_t field = 1; field & kAllPlayerStateFields; field <<= 1) {
+    if (fields & field & kTwoByteFields)
+      bits += 16;
+  }
+  if (fields & PSF_WEAPON_MODE)
+    bits += Net::kWeaponModeBits;
+  if (fields & PSF_ACTIVE_SPELL)
+    bits += Net::kSpellNrBits;
+  if (fields & PSF_HEAD_DIRECTION)
+    bits += Net::kHeadDirectionBits;
+  return (bits + 7) / 8;
+}
+
 template <typename S>
 void serialize(S& s, PlayerState& packet) {
-  s.object(packet.position);
-  s.object(packet.nrot);
-  s.value2b(packet.left_hand_item_instance);
-  s.value2b(packet.right_hand_item_instance);
-  s.value2b(packet.equipped_armor_instance);
-  s.value2b(packet.animation);
-  s.value2b(packet.health_points);
-  s.value2b(packet.mana_points);
-  s.value1b(packet.weapon_mode);
-  s.value1b(packet.active_spell_nr);
-  s.value1b(packet.head_direction);
-  s.value2b(packet.melee_weapon_instance);
-  s.value2b(packet.ranged_weapon_instance);
+  SerializePlayerStateFields(s, packet, kAllPlayerStateFields);
 }
 
 inline std::ostream& operator<<(std::ostream& os, const PlayerState& player_state) {
@@ -73,6 +73,9 @@ enum PacketID {
   PT_CASTSPELLONTARGET,
   PT_VOICE,
   PT_DISCORD_ACTIVITY,
+  PT_SNAPSHOT,  // Aggregated per-tick update about all other players, built separately for every client.
+  PT_SNAPSHOT_ACK,  // Client confirms a snapshot, so its states can be used as delta baselines.
+  PT_QUEUE_POSITION,  // Server tells a client waiting to be admitted where it is in the queue.
 };
 
 inline const char* PacketIDToString(PacketID id) {
@@ -149,6 +152,12 @@ inline const char* PacketIDToString(PacketID id) {
       return "PT_VOICE";
     case PT_DISCORD_ACTIVITY:
       return "PT_DISCORD_ACTIVITY";
+    case PT_SNAPSHOT:
+      return "PT_SNAPSHOT";
+    case PT_SNAPSHOT_ACK:
+      return "PT_SNAPSHOT_ACK";
+    case PT_QUEUE_POSITION:
+      return "PT_QUEUE_POSITION";
   }
   return "UNKNOWN";
 }
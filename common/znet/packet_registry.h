@@ -0,0 +1,336 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/bitsery.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include "net_enums.h"
+#include "packet_views.h"
+#include "packets.h"
+
+namespace Net {
+
+// Which side receives a packet. A few ids carry different data depending on the direction.
+enum class PacketDirection { kToServer, kToClient };
+
+// Payload of packets that are not bitsery structs, i.e. network library notifications, voice and rcon.
+// Handlers get the bytes as received, starting with the packet id.
+struct RawPacket {
+  unsigned char* data;
+  std::uint32_t size;
+};
+
+// Static description of a packet: how large it may get and how it is sent unless the sender knows better.
+struct PacketTraits {
+  std::uint32_t max_size;
+  PacketReliability reliability;
+  PacketPriority priority;
+  // Ordering channel, ordered packets only wait for earlier ones on the same channel.
+  std::uint32_t channel;
+};
+
+constexpr std::uint32_t kUnboundedPacketSize = std::numeric_limits<std::uint32_t>::max();
+// Independent ordering channels of the network library.
+constexpr std::uint32_t kOrderingChannelCount = 32;
+
+template <typename T, std::uint32_t MaxSize, PacketReliability Reliability = RELIABLE, PacketPriority Priority = HIGH_PRIORITY,
+          std::uint32_t Channel = 0>
+struct PacketSpec {
+  static_assert(Channel < kOrderingChannelCount, "Not an ordering channel of the network library");
+  using Type = T;
+  static constexpr PacketTraits kTraits{MaxSize, Reliability, Priority, Channel};
+};
+
+/**
+ * @brief The packet registry: maps a packet id and direction to the struct it carries and its PacketTraits
+ *
+ * Only ids that are specialized below can be received, see PacketDispatcher.
+ */
+template <PacketDirection Direction, PacketID Id>
+struct PacketDef;
+
+template <PacketDirection Direction, PacketID Id>
+concept RegisteredPacket = requires { typename PacketDef<Direction, Id>::Type; };
+
+// Ordering channel of the join burst, existing players pages and JoinGame announcements.
+constexpr std::uint32_t kJoinChannel = 1;
+
+constexpr std::uint32_t kMaxMessagePacketSize = 1040;
+constexpr std::uint32_t kMaxVoicePacketSize = 64 * 1024;
+constexpr std::uint32_t kMaxExistingPlayersPacketSize =
+    kExistingPlayersPacketHeaderSize + kMaxExistingPlayersPerPage * GetExistingPlayerInfoSize(kMaxPlayerNameLength);
+constexpr std::uint32_t kMaxSnapshotPacketSize =
+    16 + kMaxSnapshotEntries * (GetSnapshotPlayerStateSize(1, kAllPlayerStateFields) + kSnapshotPlayerPositionSize);
+
+// Packets the server receives. Delivery is how clients send them.
+template <>
+struct PacketDef<PacketDirection::kToServer, ID_NEW_INCOMING_CONNECTION> : PacketSpec<RawPacket, kUnboundedPacketSize> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, ID_DISCONNECTION_NOTIFICATION> : PacketSpec<RawPacket, kUnboundedPacketSize> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, ID_CONNECTION_LOST> : PacketSpec<RawPacket, kUnboundedPacketSize> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, ID_INCOMPATIBLE_PROTOCOL_VERSION> : PacketSpec<RawPacket, kUnboundedPacketSize> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_REQUEST_FILE_LENGTH> : PacketSpec<RawPacket, 256> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_REQUEST_FILE_PART> : PacketSpec<RawPacket, 256> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_JOIN_GAME> : PacketSpec<JoinGamePacket, 320, RELIABLE_ORDERED, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_ACTUAL_STATISTICS>
+    : PacketSpec<PlayerStateUpdatePacket, 64, RELIABLE_ORDERED, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_HP_DIFF> : PacketSpec<HPDiffPacket, 8, RELIABLE, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_MSG> : PacketSpec<MessagePacket, kMaxMessagePacketSize, RELIABLE, MEDIUM_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_WHISPER> : PacketSpec<MessagePacket, kMaxMessagePacketSize, RELIABLE_ORDERED> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_COMMAND> : PacketSpec<MessagePacket, kMaxMessagePacketSize, RELIABLE_ORDERED> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_CASTSPELL> : PacketSpec<CastSpellPacket, 16> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_CASTSPELLONTARGET> : PacketSpec<CastSpellPacket, 16> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_DROPITEM> : PacketSpec<DropItemPacket, 16> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_TAKEITEM> : PacketSpec<TakeItemPacket, 16> {};
+// A bare request for the GameInfoPacket.
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_GAME_INFO> : PacketSpec<RawPacket, 2, RELIABLE, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_VOICE> : PacketSpec<RawPacket, kMaxVoicePacketSize, UNRELIABLE, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToServer, PT_SNAPSHOT_ACK> : PacketSpec<SnapshotAckPacket, 8, UNRELIABLE, IMMEDIATE_PRIORITY> {};
+
+// Packets the clients receive. Delivery is how the server sends them.
+template <>
+struct PacketDef<PacketDirection::kToClient, ID_DISCONNECTION_NOTIFICATION> : PacketSpec<RawPacket, kUnboundedPacketSize> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, ID_CONNECTION_LOST> : PacketSpec<RawPacket, kUnboundedPacketSize> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_INITIAL_INFO> : PacketSpec<InitialInfoPacket, 80, RELIABLE, HIGH_PRIORITY, 9> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_QUEUE_POSITION> : PacketSpec<QueuePositionPacket, 8, UNRELIABLE, MEDIUM_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_JOIN_GAME> : PacketSpec<JoinGamePacket, 320, RELIABLE_ORDERED, HIGH_PRIORITY, kJoinChannel> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_EXISTING_PLAYERS>
+    : PacketSpec<ExistingPlayersPacket, kMaxExistingPlayersPacketSize, RELIABLE_ORDERED, HIGH_PRIORITY, kJoinChannel> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_ACTUAL_STATISTICS> : PacketSpec<PlayerStateUpdatePacket, 64, UNRELIABLE, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_MAP_ONLY> : PacketSpec<PlayerPositionUpdatePacket, 16, UNRELIABLE, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_SNAPSHOT> : PacketSpec<SnapshotPacket, kMaxSnapshotPacketSize, UNRELIABLE, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_MSG> : PacketSpec<MessagePacket, kMaxMessagePacketSize, RELIABLE_ORDERED, LOW_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_WHISPER> : PacketSpec<MessagePacket, kMaxMessagePacketSize, RELIABLE_ORDERED, LOW_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_SRVMSG> : PacketSpec<MessagePacket, kMaxMessagePacketSize, RELIABLE, MEDIUM_PRIORITY, 11> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_COMMAND> : PacketSpec<RawPacket, kMaxMessagePacketSize, RELIABLE_ORDERED> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_CASTSPELL> : PacketSpec<CastSpellPacket, 16> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_CASTSPELLONTARGET> : PacketSpec<CastSpellPacket, 16> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_DROPITEM> : PacketSpec<DropItemPacket, 16> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_TAKEITEM> : PacketSpec<TakeItemPacket, 16> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_VOICE> : PacketSpec<RawPacket, kMaxVoicePacketSize, UNRELIABLE, IMMEDIATE_PRIORITY, 5> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_GAME_INFO> : PacketSpec<GameInfoPacket, 8, RELIABLE, MEDIUM_PRIORITY, 9> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_DISCORD_ACTIVITY> : PacketSpec<DiscordActivityPacket, 600, RELIABLE, LOW_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_LEFT_GAME> : PacketSpec<DisconnectionInfoPacket, 8, RELIABLE, IMMEDIATE_PRIORITY> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_DODIE> : PacketSpec<PlayerDeathInfoPacket, 8, RELIABLE, IMMEDIATE_PRIORITY, 13> {};
+template <>
+struct PacketDef<PacketDirection::kToClient, PT_RESPAWN> : PacketSpec<PlayerRespawnInfoPacket, 8, RELIABLE, IMMEDIATE_PRIORITY, 13> {};
+
+/**
+ * @brief Decodes a registered packet
+ * @return false if the packet is larger than its max_size, cut short or has bytes left over
+ */
+template <PacketDirection Direction, PacketID Id>
+  requires RegisteredPacket<Direction, Id>
+bool DecodePacket(unsigned char* data, std::uint32_t size, typename PacketDef<Direction, Id>::Type& packet) {
+  using Def = PacketDef<Direction, Id>;
+  if (size > Def::kTraits.max_size) {
+    return false;
+  }
+  if constexpr (std::is_same_v<typename Def::Type, RawPacket>) {
+    packet = RawPacket{data, size};
+    return true;
+  } else {
+    using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
+    const auto [error, completed] = bitsery::quickDeserialization<InputAdapter>({data, size}, packet);
+    return error == bitsery::ReaderError::NoError && completed;
+  }
+}
+
+/**
+ * @brief Decodes a registered packet into the view of its struct, see packet_views.h
+ * @return false if the packet is larger than its max_size or doesn't decode as the struct would
+ */
+template <PacketDirection Direction, PacketID Id>
+  requires RegisteredPacket<Direction, Id>
+bool DecodePacket(unsigned char* data, std::uint32_t size, typename PacketViewOf<typename PacketDef<Direction, Id>::Type>::Type& view) {
+  return size <= PacketDef<Direction, Id>::kTraits.max_size && DecodeView(data, size, view);
+}
+
+// The packet parameter of a handler method, i.e. its last one.
+template <typename Method>
+struct HandlerPacket;
+
+template <typename Result, typename Handler, typename... Params>
+struct HandlerPacket<Result (Handler::*)(Params...)> {
+  using Type = std::remove_reference_t<std::tuple_element_t<sizeof...(Params) - 1, std::tuple<Params...>>>;
+};
+
+// Where a received packet's id and payload are.
+struct PacketHeader {
+  std::uint8_t id;
+  // Offset of the payload, which starts with the id. Non-zero if the packet is prefixed with a timestamp.
+  std::uint32_t offset;
+};
+
+/**
+ * @brief Gets the id of a received packet, looking past the ID_TIMESTAMP prefix
+ * @return std::nullopt if the packet is too short to hold an id
+ */
+inline std::optional<PacketHeader> ReadPacketHeader(const unsigned char* data, std::uint32_t size) {
+  constexpr std::uint32_t kTimestampSize = 1 + sizeof(std::uint32_t);
+  if (size == 0) {
+    return std::nullopt;
+  }
+  if (data[0] != ID_TIMESTAMP) {
+    return PacketHeader{data[0], 0};
+  }
+  if (size <= kTimestampSize) {
+    return std::nullopt;
+  }
+  return PacketHeader{data[kTimestampSize], kTimestampSize};
+}
+
+enum class DispatchResult {
+  kHandled,
+  // No handler for the packet id.
+  kUnhandled,
+  // The packet didn't decode as the struct registered for its id.
+  kMalformed,
+};
+
+// Binds a handler method to a packet id, see PacketDispatcher.
+template <PacketID Id, auto Method>
+struct PacketRoute {};
+
+/**
+ * @brief Flat table from packet id to a function that decodes the packet and calls the handler method bound to it
+ *
+ * Built at compile time from PacketRoutes, e.g. inside a member function of Handler, so private methods can be bound:
+ *
+ *   static constexpr auto kDispatcher = Net::PacketDispatcher<kToServer, GameServer, const Packet&>::Make(
+ *       Net::PacketRoute<PT_MSG, &GameServer::HandleNormalMsg>{}, ...);
+ *
+ * Bound methods take the Args passed to Dispatch, followed by the decoded PacketDef::Type, or its PacketViewOf to
+ * read strings in place. Handlers of RawPackets, which the registry can't check, may return bool, false rejecting
+ * the packet as malformed.
+ */
+template <PacketDirection Direction, typename Handler, typename... Args>
+class PacketDispatcher {
+public:
+  using DispatchFunc = DispatchResult (*)(Handler&, unsigned char*, std::uint32_t, Args...);
+
+  template <typename... Routes>
+  static constexpr PacketDispatcher Make(Routes... routes) {
+    PacketDispatcher dispatcher;
+    dispatcher.table_.fill(&Unhandled);
+    (dispatcher.Add(routes), ...);
+    return dispatcher;
+  }
+
+  DispatchResult Dispatch(Handler& handler, std::uint8_t id, unsigned char* data, std::uint32_t size, Args... args) const {
+    return table_[id](handler, data, size, args...);
+  }
+
+  bool IsRouted(std::uint8_t id) const {
+    return table_[id] != &Unhandled;
+  }
+
+private:
+  template <PacketID Id, auto Method>
+  constexpr void Add(PacketRoute<Id, Method>) {
+    static_assert(RegisteredPacket<Direction, Id>, "Packet id is not in the registry for this direction");
+    if (table_[Id] != &Unhandled) {
+      // Not a constant expression, so binding an id twice fails to compile.
+      throw std::logic_error("Packet id bound twice");
+    }
+    table_[Id] = &Decode<Id, Method>;
+  }
+
+  template <PacketID Id, auto Method>
+  static DispatchResult Decode(Handler& handler, unsigned char* data, std::uint32_t size, Args... args) {
+    using Type = typename PacketDef<Direction, Id>::Type;
+    using Packet = typename HandlerPacket<decltype(Method)>::Type;
+    static_assert(std::is_same_v<Packet, Type> || std::is_same_v<Packet, typename PacketViewOf<Type>::Type>,
+                  "Handler doesn't take the struct registered for the packet id or its view");
+    Packet packet{};
+    if (!DecodePacket<Direction, Id>(data, size, packet)) {
+      return DispatchResult::kMalformed;
+    }
+    if constexpr (std::is_same_v<decltype((handler.*Method)(args..., packet)), bool>) {
+      if (!(handler.*Method)(args..., packet)) {
+        return DispatchResult::kMalformed;
+      }
+    } else {
+      (handler.*Method)(args..., packet);
+    }
+    return DispatchResult::kHandled;
+  }
+
+  static DispatchResult Unhandled(Handler&, unsigned char*, std::uint32_t, Args...) {
+    return DispatchResult::kUnhandled;
+  }
+
+  std::array<DispatchFunc, 256> table_{};
+};
+
+}  // namespace Net
@@ -0,0 +1,286 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/bitsery.h>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "packets.h"
+
+// Views decode a packet without copying its strings out of the receive buffer. They are only valid as long as
+// that buffer, i.e. for the duration of the packet handler.
+
+namespace Net {
+
+/**
+ * @brief Reads values laid out the way bitsery writes them, straight from the received bytes
+ *
+ * Any read past the end or of invalid data fails the reader, after which all reads fail.
+ */
+class PacketReader {
+public:
+  PacketReader(const unsigned char* data, std::uint32_t size) : data_(data), size_(size) {
+  }
+
+  template <typename T>
+  bool Read(T& value) {
+    // bitsery writes little endian, so values can be copied as is.
+    static_assert(std::endian::native == std::endian::little && std::is_trivially_copyable_v<T>);
+    if (!Ensure(sizeof(T))) {
+      return false;
+    }
+    std::memcpy(&value, data_ + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadBool(bool& value) {
+    std::uint8_t byte = 0;
+    if (!Read(byte) || byte > 1) {
+      return Fail();
+    }
+    value = byte == 1;
+    return true;
+  }
+
+  // Container and text length, 1, 2 or 4 bytes depending on the value.
+  bool ReadSize(std::size_t& size, std::size_t max_size) {
+    std::uint8_t high = 0;
+    if (!Read(high)) {
+      return false;
+    }
+    if (high & 0x80u) {
+      std::uint8_t low = 0;
+      if (!Read(low)) {
+        return false;
+      }
+      if (high & 0x40u) {
+        std::uint16_t lowest = 0;
+        if (!Read(lowest)) {
+          return false;
+        }
+        size = (static_cast<std::size_t>(high & 0x3Fu) << 24) | (static_cast<std::size_t>(low) << 16) | lowest;
+      } else {
+        size = (static_cast<std::size_t>(high & 0x7Fu) << 8) | low;
+      }
+    } else {
+      size = high;
+    }
+    return size <= max_size || Fail();
+  }
+
+  bool ReadText(std::string_view& text, std::size_t max_size) {
+    std::size_t size = 0;
+    if (!ReadSize(size, max_size) || !Ensure(size)) {
+      return false;
+    }
+    text = std::string_view(reinterpret_cast<const char*>(data_ + position_), size);
+    position_ += size;
+    return true;
+  }
+
+  template <typename T>
+  bool ReadOptional(std::optional<T>& value) {
+    bool has_value = false;
+    if (!ReadBool(has_value)) {
+      return false;
+    }
+    value.reset();
+    if (has_value) {
+      T inner{};
+      if (!Read(inner)) {
+        return false;
+      }
+      value = inner;
+    }
+    return true;
+  }
+
+  // Decodes the next `size` bytes with bitsery, for parts without strings, e.g. bit-packed ones.
+  template <typename T>
+  bool ReadObject(T& object, std::size_t size) {
+    if (!Ensure(size)) {
+      return false;
+    }
+    using InputAdapter = bitsery::InputBufferAdapter<const unsigned char*>;
+    const auto [error, completed] = bitsery::quickDeserialization<InputAdapter>({data_ + position_, size}, object);
+    if (error != bitsery::ReaderError::NoError || !completed) {
+      return Fail();
+    }
+    position_ += size;
+    return true;
+  }
+
+  std::uint32_t GetPosition() const {
+    return position_;
+  }
+
+  // Whether everything was read successfully and nothing is left over.
+  bool IsCompleted() const {
+    return !failed_ && position_ == size_;
+  }
+
+private:
+  bool Ensure(std::size_t size) {
+    return (!failed_ && size <= size_ - position_) || Fail();
+  }
+
+  bool Fail() {
+    failed_ = true;
+    return false;
+  }
+
+  const unsigned char* data_;
+  std::uint32_t size_;
+  std::uint32_t position_{0};
+  bool failed_{false};
+};
+
+/**
+ * @brief MessagePacket with the message left in the receive buffer
+ */
+struct MessagePacketView {
+  std::uint8_t packet_type{0};
+  std::string_view message;
+  std::optional<NetId> sender;
+  std::optional<NetId> recipient;
+  // The received bytes and where the sender is in them, see WriteMessageWithSender.
+  const unsigned char* data{nullptr};
+  std::uint32_t size{0};
+  std::uint32_t sender_begin{0};
+  std::uint32_t sender_end{0};
+};
+
+inline bool DecodeView(const unsigned char* data, std::uint32_t size, MessagePacketView& view) {
+  PacketReader reader(data, size);
+  reader.Read(view.packet_type);
+  reader.ReadText(view.message, kMaxMessageLength);
+  view.sender_begin = reader.GetPosition();
+  reader.ReadOptional(view.sender);
+  view.sender_end = reader.GetPosition();
+  reader.ReadOptional(view.recipient);
+  view.data = data;
+  view.size = size;
+  return reader.IsCompleted();
+}
+
+/**
+ * @brief Writes the received message with its sender set to `sender` and all other bytes as received
+ * @return The number of bytes written to the front of the buffer
+ */
+inline std::size_t WriteMessageWithSender(const MessagePacketView& view, NetId sender, std::vector<std::uint8_t>& buffer) {
+  constexpr std::size_t kSenderSize = 1 + sizeof(NetId);
+  const std::size_t tail_size = view.size - view.sender_end;
+  const std::size_t size = view.sender_begin + kSenderSize + tail_size;
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+  std::memcpy(buffer.data(), view.data, view.sender_begin);
+  buffer[view.sender_begin] = 1;
+  std::memcpy(buffer.data() + view.sender_begin + 1, &sender, sizeof(NetId));
+  std::memcpy(buffer.data() + view.sender_begin + kSenderSize, view.data + view.sender_end, tail_size);
+  return size;
+}
+
+/**
+ * @brief JoinGamePacket with the player name left in the receive buffer
+ */
+struct JoinGamePacketView {
+  std::uint8_t packet_type{0};
+  std::uint8_t selected_class{0};
+  glm::vec3 position{0.0f};
+  glm::vec3 normal{0.0f};
+  std::int16_t left_hand_item_instance{0};
+  std::int16_t right_hand_item_instance{0};
+  std::int16_t equipped_armor_instance{0};
+  std::int16_t animation{0};
+  std::uint8_t head_model{0};
+  std::uint8_t skin_texture{0};
+  std::uint8_t face_texture{0};
+  std::uint8_t walk_style{0};
+  std::string_view player_name;
+  std::optional<NetId> player_id;
+};
+
+namespace detail {
+
+struct JoinTransform {
+  glm::vec3 position{0.0f};
+  glm::vec3 normal{0.0f};
+};
+
+template <typename S>
+void serialize(S& s, JoinTransform& transform) {
+  SerializeJoinTransform(s, transform.position, transform.normal);
+}
+
+}  // namespace detail
+
+inline bool DecodeView(const unsigned char* data, std::uint32_t size, JoinGamePacketView& view) {
+  PacketReader reader(data, size);
+  detail::JoinTransform transform;
+  reader.Read(view.packet_type);
+  reader.Read(view.selected_class);
+  reader.ReadObject(transform, kJoinTransformSize);
+  reader.Read(view.left_hand_item_instance);
+  reader.Read(view.right_hand_item_instance);
+  reader.Read(view.equipped_armor_instance);
+  reader.Read(view.animation);
+  reader.Read(view.head_model);
+  reader.Read(view.skin_texture);
+  reader.Read(view.face_texture);
+  reader.Read(view.walk_style);
+  reader.ReadText(view.player_name, kMaxPlayerNameLength);
+  reader.ReadOptional(view.player_id);
+  view.position = transform.position;
+  view.normal = transform.normal;
+  return reader.IsCompleted();
+}
+
+// The view a registered packet struct can be decoded into instead, void if there is none.
+template <typename T>
+struct PacketViewOf {
+  using Type = void;
+};
+
+template <>
+struct PacketViewOf<MessagePacket> {
+  using Type = MessagePacketView;
+};
+
+template <>
+struct PacketViewOf<JoinGamePacket> {
+  using Type = JoinGamePacketView;
+};
+
+}  // namespace Net
@@ -48,9 +48,13 @@ void serialize(S& s, glm::vec3& vec) {
 }
 }  // namespace glm
 
+// Text limits, enforced when decoding.
+constexpr std::size_t kMaxPlayerNameLength = 255;
+constexpr std::size_t kMaxMessageLength = 1024;
+
 struct ExistingPlayerInfo {
   std::uint8_t packet_type{0};
-  std::uint32_t player_id{0};
+  NetId player_id{0};
   std::uint8_t selected_class{0};
   glm::vec3 position{0.0f};
   std::int16_t left_hand_item_instance{0};
@@ -65,9 +69,9 @@ struct ExistingPlayerInfo {
 
 template <typename S>
 void serialize(S& s, ExistingPlayerInfo& info) {
-  s.value4b(info.player_id);
+  s.value2b(info.player_id);
   s.value1b(info.selected_class);
-  s.object(info.position);
+  s.enableBitPacking([&info](typename S::BPEnabledType& sbp) { sbp.ext(info.position, Net::QuantizedPosition{}); });
   s.value2b(info.left_hand_item_instance);
   s.value2b(info.right_hand_item_instance);
   s.value2b(info.equipped_armor_instance);
@@ -75,7 +79,7 @@ void serialize(S& s, ExistingPlayerInfo& info) {
   s.value1b(info.skin_texture);
   s.value1b(info.face_texture);
   s.value1b(info.walk_style);
-  s.text1b(info.player_name, 255);
+  s.text1b(info.player_name, kMaxPlayerNameLength);
 }
 
 inline std::ostream& operator<<(std::ostream& os, const ExistingPlayerInfo& packet) {
@@ -93,17 +97,64 @@ inline std::ostream& operator<<(std::ostream& os, const ExistingPlayerInfo& pack
 template <>
 struct fmt::formatter<ExistingPlayerInfo> : ostream_formatter {};
 
+// Bytes serialize writes for an ExistingPlayerInfo with a name of name_length characters.
+constexpr std::size_t GetExistingPlayerInfoSize(std::size_t name_length) {
+  return sizeof(NetId) + sizeof(std::uint8_t) + GetPlayerStateFieldsSize(PSF_POSITION) + 3 * sizeof(std::int16_t) + 4 * sizeof(std::uint8_t) +
+         (name_length < 0x80 ? 1 : 2) + name_length;
+}
+
+// Upper bound for the number of players in a single page. Pages are normally cut much earlier by their byte size.
+// Below 0x80, so bitsery writes the player count as a single byte, see ExistingPlayersPageHeader.
+constexpr std::size_t kMaxExistingPlayersPerPage = 127;
+
+// One page of the players already in game, sent to a joining player. The server sends as many pages as needed,
+// nearest players first, and sets last_page on the final one (which may be empty).
 struct ExistingPlayersPacket {
   std::uint8_t packet_type{0};
+  std::uint16_t page{0};
+  bool last_page{true};
   std::vector<ExistingPlayerInfo> existing_players;
 };
 
 template <typename S>
 void serialize(S& s, ExistingPlayersPacket& packet) {
   s.value1b(packet.packet_type);
-  s.container(packet.existing_players, 400);
+  s.value2b(packet.page);
+  s.boolValue(packet.last_page);
+  s.container(packet.existing_players, kMaxExistingPlayersPerPage);
 }
 
+// The part of an ExistingPlayersPacket before the first player, for pages assembled from separately serialized
+// ExistingPlayerInfo. Followed by `count` of them, the bytes are the same as those of the whole packet.
+struct ExistingPlayersPageHeader {
+  std::uint8_t packet_type{0};
+  std::uint16_t page{0};
+  bool last_page{true};
+  std::uint8_t count{0};
+};
+
+template <typename S>
+void serialize(S& s, ExistingPlayersPageHeader& header) {
+  s.value1b(header.packet_type);
+  s.value2b(header.page);
+  s.boolValue(header.last_page);
+  s.value1b(header.count);
+}
+
+// Bytes serialize writes for an ExistingPlayersPacket before the first player.
+constexpr std::size_t kExistingPlayersPacketHeaderSize = sizeof(std::uint8_t) + sizeof(std::uint16_t) + 2 * sizeof(std::uint8_t);
+
+// Position and heading of a joining player, bit-packed together. Shared with JoinGamePacketView.
+template <typename S>
+void SerializeJoinTransform(S& s, glm::vec3& position, glm::vec3& normal) {
+  s.enableBitPacking([&position, &normal](typename S::BPEnabledType& sbp) {
+    sbp.ext(position, Net::QuantizedPosition{});
+    sbp.ext(normal, Net::QuantizedNormal{});
+  });
+}
+
+constexpr std::size_t kJoinTransformSize = GetPlayerStateFieldsSize(PSF_POSITION | PSF_NROT);
+
 struct JoinGamePacket {
   std::uint8_t packet_type{0};
   std::uint8_t selected_class{0};
@@ -119,15 +170,14 @@ struct JoinGamePacket {
   std::uint8_t walk_style{0};
   std::string player_name;
   // May be used to identify the player (e.g. when relaying the information about the player to other players)
-  std::optional<std::uint32_t> player_id;
+  std::optional<NetId> player_id;
 };
 
 template <typename S>
 void serialize(S& s, JoinGamePacket& packet) {
   s.value1b(packet.packet_type);
   s.value1b(packet.selected_class);
-  s.object(packet.position);
-  s.object(packet.normal);
+  SerializeJoinTransform(s, packet.position, packet.normal);
   s.value2b(packet.left_hand_item_instance);
   s.value2b(packet.right_hand_item_instance);
   s.value2b(packet.equipped_armor_instance);
@@ -136,8 +186,8 @@ void serialize(S& s, JoinGamePacket& packet) {
   s.value1b(packet.skin_texture);
   s.value1b(packet.face_texture);
   s.value1b(packet.walk_style);
-  s.text1b(packet.player_name, 255);
-  s.ext4b(packet.player_id, bitsery::ext::StdOptional{});
+  s.text1b(packet.player_name, kMaxPlayerNameLength);
+  s.ext2b(packet.player_id, bitsery::ext::StdOptional{});
 }
 
 inline std::ostream& operator<<(std::ostream& os, const JoinGamePacket& packet) {
@@ -165,16 +215,16 @@ struct fmt::formatter<JoinGamePacket> : ostream_formatter {};
 struct MessagePacket {
   std::uint8_t packet_type;
   std::string message;
-  std::optional<std::uint32_t> sender;
-  std::optional<std::uint32_t> recipient;
+  std::optional<NetId> sender;
+  std::optional<NetId> recipient;
 };
 
 template <typename S>
 void serialize(S& s, MessagePacket& packet) {
   s.value1b(packet.packet_type);
-  s.text1b(packet.message, 1024);
-  s.ext4b(packet.sender, bitsery::ext::StdOptional{});
-  s.ext4b(packet.recipient, bitsery::ext::StdOptional{});
+  s.text1b(packet.message, kMaxMessageLength);
+  s.ext2b(packet.sender, bitsery::ext::StdOptional{});
+  s.ext2b(packet.recipient, bitsery::ext::StdOptional{});
 }
 
 inline std::ostream& operator<<(std::ostream& os, const MessagePacket& packet) {
@@ -196,16 +246,16 @@ struct fmt::formatter<MessagePacket> : ostream_formatter {};
 struct CastSpellPacket {
   std::uint8_t packet_type;
   std::uint16_t spell_id;
-  std::optional<std::uint32_t> target_id;
-  std::optional<std::uint32_t> caster_id;
+  std::optional<NetId> target_id;
+  std::optional<NetId> caster_id;
 };
 
 template <typename S>
 void serialize(S& s, CastSpellPacket& packet) {
   s.value1b(packet.packet_type);
   s.value2b(packet.spell_id);
-  s.ext4b(packet.target_id, bitsery::ext::StdOptional{});
-  s.ext4b(packet.caster_id, bitsery::ext::StdOptional{});
+  s.ext2b(packet.target_id, bitsery::ext::StdOptional{});
+  s.ext2b(packet.caster_id, bitsery::ext::StdOptional{});
 }
 
 inline std::ostream& operator<<(std::ostream& os, const CastSpellPacket& packet) {
@@ -222,7 +272,7 @@ struct DropItemPacket {
   std::uint8_t packet_type;
   std::int16_t item_instance;
   std::int16_t item_amount;
-  std::optional<std::uint32_t> player_id;
+  std::optional<NetId> player_id;
 };
 
 template <typename S>
@@ -230,7 +280,7 @@ void serialize(S& s, DropItemPacket& packet) {
   s.value1b(packet.packet_type);
   s.value2b(packet.item_instance);
   s.value2b(packet.item_amount);
-  s.ext4b(packet.player_id, bitsery::ext::StdOptional{});
+  s.ext2b(packet.player_id, bitsery::ext::StdOptional{});
 }
 
 inline std::ostream& operator<<(std::ostream& os, const DropItemPacket& packet) {
@@ -247,14 +297,14 @@ inline std::ostream& operator<<(std::ostream& os, const DropItemPacket& packet)
 struct TakeItemPacket {
   std::uint8_t packet_type;
   std::int16_t item_instance;
-  std::optional<std::uint32_t> player_id;
+  std::optional<NetId> player_id;
 };
 
 template <typename S>
 void serialize(S& s, TakeItemPacket& packet) {
   s.value1b(packet.packet_type);
   s.value2b(packet.item_instance);
-  s.ext4b(packet.player_id, bitsery::ext::StdOptional{});
+  s.ext2b(packet.player_id, bitsery::ext::StdOptional{});
 }
 
 inline std::ostream& operator<<(std::ostream& os, const TakeItemPacket& packet) {
@@ -271,14 +321,14 @@ struct PlayerStateUpdatePacket {
   std::uint8_t packet_type;
   PlayerState state;
   // May be used to identify the player (e.g. when relaying the information about the player to other players)
-  std::optional<std::uint32_t> player_id;
+  std::optional<NetId> player_id;
 };
 
 template <typename S>
 void serialize(S& s, PlayerStateUpdatePacket& packet) {
   s.value1b(packet.packet_type);
   s.object(packet.state);
-  s.ext4b(packet.player_id, bitsery::ext::StdOptional{});
+  s.ext2b(packet.player_id, bitsery::ext::StdOptional{});
 }
 
 inline std::ostream& operator<<(std::ostream& os, const PlayerStateUpdatePacket& packet) {
@@ -298,14 +348,14 @@ struct PlayerPositionUpdatePacket {
   std::uint8_t packet_type;
   glm::vec3 position;
   // May be used to identify the player (e.g. when relaying the information about the player to other players)
-  std::optional<std::uint32_t> player_id;
+  std::optional<NetId> player_id;
 };
 
 template <typename S>
 void serialize(S& s, PlayerPositionUpdatePacket& packet) {
   s.value1b(packet.packet_type);
-  s.object(packet.position);
-  s.ext4b(packet.player_id, bitsery::ext::StdOptional{});
+  s.enableBitPacking([&packet](typename S::BPEnabledType& sbp) { sbp.ext(packet.position, Net::QuantizedPosition{}); });
+  s.ext2b(packet.player_id, bitsery::ext::StdOptional{});
 }
 
 inline std::ostream& operator<<(std::ostream& os, const PlayerPositionUpdatePacket& packet) {
@@ -319,16 +369,117 @@ inline std::ostream& operator<<(std::ostream& os, const PlayerPositionUpdatePack
   return os;
 }
 
+// Upper bound for the number of entries in each list of a snapshot.
+constexpr std::size_t kMaxSnapshotEntries = 4096;
+
+// A full state when baseline_age is 0. Otherwise only the fields in changed_fields are sent and the rest is taken
+// from the state the recipient got in snapshot (sequence - baseline_age).
+struct SnapshotPlayerState {
+  NetId player_id{0};
+  std::uint8_t baseline_age{0};
+  std::uint16_t changed_fields{kAllPlayerStateFields};
+  PlayerState state;
+};
+
+template <typename S>
+void serialize(S& s, SnapshotPlayerState& entry) {
+  s.value2b(entry.player_id);
+  s.value1b(entry.baseline_age);
+  if (entry.baseline_age == 0) {
+    entry.changed_fields = kAllPlayerStateFields;
+    s.object(entry.state);
+    return;
+  }
+  s.value2b(entry.changed_fields);
+  SerializePlayerStateFields(s, entry.state, entry.changed_fields);
+}
+
+// Bytes serialize writes for a state entry with the given baseline_age and changed_fields.
+constexpr std::size_t GetSnapshotPlayerStateSize(std::uint8_t baseline_age, std::uint16_t changed_fields) {
+  if (baseline_age == 0) {
+    return sizeof(NetId) + sizeof(std::uint8_t) + GetPlayerStateFieldsSize(kAllPlayerStateFields);
+  }
+  return sizeof(NetId) + sizeof(std::uint8_t) + sizeof(std::uint16_t) + GetPlayerStateFieldsSize(changed_fields);
+}
+
+struct SnapshotPlayerPosition {
+  NetId player_id{0};
+  glm::vec3 position{0.0f};
+};
+
+template <typename S>
+void serialize(S& s, SnapshotPlayerPosition& entry) {
+  s.value2b(entry.player_id);
+  s.enableBitPacking([&entry](typename S::BPEnabledType& sbp) { sbp.ext(entry.position, Net::QuantizedPosition{}); });
+}
+
+constexpr std::size_t kSnapshotPlayerPositionSize = sizeof(NetId) + GetPlayerStateFieldsSize(PSF_POSITION);
+
+// Everything a single client needs to know about the other players for one tick.
+// Nearby players are sent with their full state, players further away only with their position.
+struct SnapshotPacket {
+  std::uint8_t packet_type{0};
+  // Per-recipient counter, wraps around.
+  std::uint16_t sequence{0};
+  // Tick the snapshot was built in and the server clock at that tick, in milliseconds since the server started.
+  // Both are the same for every recipient, so clients can place the states on the server's timeline.
+  std::uint32_t server_tick{0};
+  std::uint32_t server_time_ms{0};
+  std::vector<SnapshotPlayerState> player_states;
+  std::vector<SnapshotPlayerPosition> player_positions;
+};
+
+template <typename S>
+void serialize(S& s, SnapshotPacket& packet) {
+  s.value1b(packet.packet_type);
+  s.value2b(packet.sequence);
+  s.value4b(packet.server_tick);
+  s.value4b(packet.server_time_ms);
+  s.container(packet.player_states, kMaxSnapshotEntries);
+  s.container(packet.player_positions, kMaxSnapshotEntries);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const SnapshotPacket& packet) {
+  os << "SnapshotPacket {"
+     << " packet_type: " << static_cast<int>(packet.packet_type) << ", sequence: " << packet.sequence
+     << ", server_tick: " << packet.server_tick << ", server_time_ms: " << packet.server_time_ms
+     << ", player_states: " << packet.player_states.size() << ", player_positions: " << packet.player_positions.size() << " }";
+  return os;
+}
+
+template <>
+struct fmt::formatter<SnapshotPacket> : ostream_formatter {};
+
+struct SnapshotAckPacket {
+  std::uint8_t packet_type{0};
+  std::uint16_t sequence{0};
+};
+
+template <typename S>
+void serialize(S& s, SnapshotAckPacket& packet) {
+  s.value1b(packet.packet_type);
+  s.value2b(packet.sequence);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const SnapshotAckPacket& packet) {
+  os << "SnapshotAckPacket {"
+     << " packet_type: " << static_cast<int>(packet.packet_type) << ", sequence: " << packet.sequence << " }";
+  return os;
+}
+
+template <>
+struct fmt::formatter<SnapshotAckPacket> : ostream_formatter {};
+
 struct HPDiffPacket {
   std::uint8_t packet_type;
-  std::uint32_t player_id;
+  NetId player_id;
   std::int16_t hp_difference;
 };
 
 template <typename S>
 void serialize(S& s, HPDiffPacket& packet) {
   s.value1b(packet.packet_type);
-  s.value4b(packet.player_id);
+  s.value2b(packet.player_id);
   s.value2b(packet.hp_difference);
 }
 
@@ -354,13 +505,13 @@ void serialize(S& s, VoicePacket& packet) {
 
 struct DisconnectionInfoPacket {
   std::uint8_t packet_type;
-  std::uint32_t disconnected_id;
+  NetId disconnected_id;
 };
 
 template <typename S>
 void serialize(S& s, DisconnectionInfoPacket& packet) {
   s.value1b(packet.packet_type);
-  s.value4b(packet.disconnected_id);
+  s.value2b(packet.disconnected_id);
 }
 
 inline std::ostream& operator<<(std::ostream& os, const DisconnectionInfoPacket& info) {
@@ -371,13 +522,13 @@ inline std::ostream& operator<<(std::ostream& os, const DisconnectionInfoPacket&
 
 struct PlayerDeathInfoPacket {
   std::uint8_t packet_type;
-  std::uint32_t player_id;
+  NetId player_id;
 };
 
 template <typename S>
 void serialize(S& s, PlayerDeathInfoPacket& packet) {
   s.value1b(packet.packet_type);
-  s.value4b(packet.player_id);
+  s.value2b(packet.player_id);
 }
 
 inline std::ostream& operator<<(std::ostream& os, const PlayerDeathInfoPacket& info) {
@@ -388,13 +539,13 @@ inline std::ostream& operator<<(std::ostream& os, const PlayerDeathInfoPacket& i
 
 struct PlayerRespawnInfoPacket {
   std::uint8_t packet_type;
-  std::uint32_t player_id;
+  NetId player_id;
 };
 
 template <typename S>
 void serialize(S& s, PlayerRespawnInfoPacket& packet) {
   s.value1b(packet.packet_type);
-  s.value4b(packet.player_id);
+  s.value2b(packet.player_id);
 }
 
 inline std::ostream& operator<<(std::ostream& os, const PlayerRespawnInfoPacket& info) {
@@ -407,14 +558,14 @@ inline std::ostream& operator<<(std::ostream& os, const PlayerRespawnInfoPacket&
 struct InitialInfoPacket {
   std::uint8_t packet_type;
   std::string map_name;
-  std::uint32_t player_id;
+  NetId player_id;
 };
 
 template <typename S>
 void serialize(S& s, InitialInfoPacket& packet) {
   s.value1b(packet.packet_type);
   s.text1b(packet.map_name, 64);
-  s.value4b(packet.player_id);
+  s.value2b(packet.player_id);
 }
 
 inline std::ostream& operator<<(std::ostream& os, const InitialInfoPacket& packet) {
@@ -426,6 +577,32 @@ inline std::ostream& operator<<(std::ostream& os, const InitialInfoPacket& packe
 template <>
 struct fmt::formatter<InitialInfoPacket> : ostream_formatter {};
 
+// Server informs a client that its connection or join request is queued, and where. Sent when the client gets queued and
+// then periodically while its position changes. Once admitted, the client gets the usual InitialInfo or ExistingPlayers.
+struct QueuePositionPacket {
+  std::uint8_t packet_type{0};
+  // 1-based.
+  std::uint16_t position{0};
+  std::uint16_t queue_size{0};
+};
+
+template <typename S>
+void serialize(S& s, QueuePositionPacket& packet) {
+  s.value1b(packet.packet_type);
+  s.value2b(packet.position);
+  s.value2b(packet.queue_size);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const QueuePositionPacket& packet) {
+  os << "QueuePositionPacket {"
+     << " packet_type: " << static_cast<int>(packet.packet_type) << ", position: " << packet.position << ", queue_size: " << packet.queue_size
+     << " }";
+  return os;
+}
+
+template <>
+struct fmt::formatter<QueuePositionPacket> : ostream_formatter {};
+
 struct GameInfoPacket {
   std::uint8_t packet_type;
   std::uint32_t raw_game_time{0};
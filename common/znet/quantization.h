@@ -0,0 +1,285 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <bitsery/bitsery.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <type_traits>
+
+// Compile-time quantization settings. Client and server must be built with the same values,
+// override them with defines to trade bandwidth for precision.
+
+// Half of the world size on the X and Z axes, in world units (cm). Positions outside are clamped.
+#ifndef GMP_QUANTIZATION_WORLD_HALF_EXTENT
+#define GMP_QUANTIZATION_WORLD_HALF_EXTENT 200000.0f
+#endif
+
+// Half of the world size on the Y axis, in world units (cm).
+#ifndef GMP_QUANTIZATION_WORLD_HALF_HEIGHT
+#define GMP_QUANTIZATION_WORLD_HALF_HEIGHT 50000.0f
+#endif
+
+// Size of a position quantization step, in world units (cm).
+#ifndef GMP_QUANTIZATION_POSITION_PRECISION
+#define GMP_QUANTIZATION_POSITION_PRECISION 1.0f
+#endif
+
+// Bits per component of the octahedral encoding used for unit vectors.
+#ifndef GMP_QUANTIZATION_NORMAL_COMPONENT_BITS
+#define GMP_QUANTIZATION_NORMAL_COMPONENT_BITS 12
+#endif
+
+#ifndef GMP_QUANTIZATION_WEAPON_MODE_BITS
+#define GMP_QUANTIZATION_WEAPON_MODE_BITS 4
+#endif
+
+#ifndef GMP_QUANTIZATION_HEAD_DIRECTION_BITS
+#define GMP_QUANTIZATION_HEAD_DIRECTION_BITS 3
+#endif
+
+#ifndef GMP_QUANTIZATION_SPELL_NR_BITS
+#define GMP_QUANTIZATION_SPELL_NR_BITS 7
+#endif
+
+namespace Net {
+
+constexpr float kWorldHalfExtent = GMP_QUANTIZATION_WORLD_HALF_EXTENT;
+constexpr float kWorldHalfHeight = GMP_QUANTIZATION_WORLD_HALF_HEIGHT;
+constexpr float kPositionPrecision = GMP_QUANTIZATION_POSITION_PRECISION;
+constexpr std::size_t kNormalComponentBits = GMP_QUANTIZATION_NORMAL_COMPONENT_BITS;
+constexpr std::size_t kWeaponModeBits = GMP_QUANTIZATION_WEAPON_MODE_BITS;
+constexpr std::size_t kHeadDirectionBits = GMP_QUANTIZATION_HEAD_DIRECTION_BITS;
+constexpr std::size_t kSpellNrBits = GMP_QUANTIZATION_SPELL_NR_BITS;
+
+static_assert(kPositionPrecision > 0.0f, "Position precision must be positive");
+static_assert(kNormalComponentBits >= 2 && kNormalComponentBits <= 16, "Normal components must fit in 2 to 16 bits");
+
+/**
+ * @brief Quantizes a float in [-half_range, half_range] to a fixed number of steps
+ */
+class FixedPointRange {
+public:
+  constexpr FixedPointRange(float half_range, float precision)
+      : half_range_(half_range), precision_(precision), max_step_(static_cast<std::uint32_t>(2.0f * half_range / precision + 0.5f)) {
+  }
+
+  constexpr std::size_t GetRequiredBits() const {
+    std::size_t bits = 1;
+    while (bits < 32 && (std::uint64_t{1} << bits) <= max_step_) {
+      ++bits;
+    }
+    return bits;
+  }
+
+  std::uint32_t Encode(float value) const {
+    const float step = std::round((value + half_range_) / precision_);
+    // Also catches NaN, which fails both comparisons.
+    if (!(step > 0.0f)) {
+      return 0;
+    }
+    if (!(step < static_cast<float>(max_step_))) {
+      return max_step_;
+    }
+    return static_cast<std::uint32_t>(step);
+  }
+
+  float Decode(std::uint32_t step) const {
+    return static_cast<float>(std::min(step, max_step_)) * precision_ - half_range_;
+  }
+
+private:
+  float half_range_;
+  float precision_;
+  std::uint32_t max_step_;
+};
+
+constexpr FixedPointRange kHorizontalPositionRange{kWorldHalfExtent, kPositionPrecision};
+constexpr FixedPointRange kVerticalPositionRange{kWorldHalfHeight, kPositionPrecision};
+constexpr std::size_t kHorizontalPositionBits = kHorizontalPositionRange.GetRequiredBits();
+constexpr std::size_t kVerticalPositionBits = kVerticalPositionRange.GetRequiredBits();
+
+/**
+ * @brief Octahedral encoding of a direction, two components in [0, 2^kNormalComponentBits - 1]
+ *
+ * Zero vectors have no direction and come back as (0, 0, 1).
+ */
+struct OctahedralNormal {
+  std::uint16_t u{0};
+  std::uint16_t v{0};
+};
+
+namespace detail {
+
+constexpr float kNormalMaxStep = static_cast<float>((1u << kNormalComponentBits) - 1);
+
+inline float SignNotZero(float value) {
+  return value < 0.0f ? -1.0f : 1.0f;
+}
+
+inline std::uint16_t EncodeUnitComponent(float value) {
+  return static_cast<std::uint16_t>(std::round((std::clamp(value, -1.0f, 1.0f) * 0.5f + 0.5f) * kNormalMaxStep));
+}
+
+inline float DecodeUnitComponent(std::uint16_t step) {
+  return static_cast<float>(step) / kNormalMaxStep * 2.0f - 1.0f;
+}
+
+}  // namespace detail
+
+inline OctahedralNormal EncodeOctahedral(const glm::vec3& direction) {
+  const float l1_norm = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+  if (!(l1_norm > 0.0f) || !std::isfinite(l1_norm)) {
+    return {detail::EncodeUnitComponent(0.0f), detail::EncodeUnitComponent(0.0f)};
+  }
+
+  float x = direction.x / l1_norm;
+  float y = direction.y / l1_norm;
+  // Fold the lower hemisphere over the diagonals.
+  if (direction.z < 0.0f) {
+    const float folded_x = (1.0f - std::abs(y)) * detail::SignNotZero(x);
+    y = (1.0f - std::abs(x)) * detail::SignNotZero(y);
+    x = folded_x;
+  }
+  return {detail::EncodeUnitComponent(x), detail::EncodeUnitComponent(y)};
+}
+
+inline glm::vec3 DecodeOctahedral(const OctahedralNormal& encoded) {
+  glm::vec3 direction(detail::DecodeUnitComponent(encoded.u), detail::DecodeUnitComponent(encoded.v), 0.0f);
+  direction.z = 1.0f - std::abs(direction.x) - std::abs(direction.y);
+  if (direction.z < 0.0f) {
+    const float unfolded_x = (1.0f - std::abs(direction.y)) * detail::SignNotZero(direction.x);
+    direction.y = (1.0f - std::abs(direction.x)) * detail::SignNotZero(direction.y);
+    direction.x = unfolded_x;
+  }
+  return glm::normalize(direction);
+}
+
+/**
+ * @brief bitsery extension writing a position as fixed point within the world extents
+ *
+ * Requires bit packing, e.g. s.enableBitPacking([&](typename S::BPEnabledType& sbp) { sbp.ext(pos, QuantizedPosition{}); });
+ */
+class QuantizedPosition {
+public:
+  template <typename Ser, typename Fnc>
+  void serialize(Ser& ser, const glm::vec3& position, Fnc&&) const {
+    auto& writer = ser.adapter();
+    writer.writeBits(kHorizontalPositionRange.Encode(position.x), kHorizontalPositionBits);
+    writer.writeBits(kVerticalPositionRange.Encode(position.y), kVerticalPositionBits);
+    writer.writeBits(kHorizontalPositionRange.Encode(position.z), kHorizontalPositionBits);
+  }
+
+  template <typename Des, typename Fnc>
+  void deserialize(Des& des, glm::vec3& position, Fnc&&) const {
+    auto& reader = des.adapter();
+    std::uint32_t x = 0;
+    std::uint32_t y = 0;
+    std::uint32_t z = 0;
+    reader.readBits(x, kHorizontalPositionBits);
+    reader.readBits(y, kVerticalPositionBits);
+    reader.readBits(z, kHorizontalPositionBits);
+    position = glm::vec3(kHorizontalPositionRange.Decode(x), kVerticalPositionRange.Decode(y), kHorizontalPositionRange.Decode(z));
+  }
+};
+
+/**
+ * @brief bitsery extension writing a direction vector with the octahedral encoding. The length is not preserved.
+ */
+class QuantizedNormal {
+public:
+  template <typename Ser, typename Fnc>
+  void serialize(Ser& ser, const glm::vec3& direction, Fnc&&) const {
+    const OctahedralNormal encoded = EncodeOctahedral(direction);
+    ser.adapter().writeBits(encoded.u, kNormalComponentBits);
+    ser.adapter().writeBits(encoded.v, kNormalComponentBits);
+  }
+
+  template <typename Des, typename Fnc>
+  void deserialize(Des& des, glm::vec3& direction, Fnc&&) const {
+    OctahedralNormal encoded;
+    des.adapter().readBits(encoded.u, kNormalComponentBits);
+    des.adapter().readBits(encoded.v, kNormalComponentBits);
+    direction = DecodeOctahedral(encoded);
+  }
+};
+
+/**
+ * @brief bitsery extension writing an unsigned value in a fixed number of bits. Larger values are clamped.
+ */
+template <std::size_t Bits>
+class BoundedUInt {
+public:
+  template <typename Ser, typename T, typename Fnc>
+  void serialize(Ser& ser, const T& value, Fnc&&) const {
+    static_assert(std::is_unsigned_v<T> && Bits <= std::numeric_limits<T>::digits);
+    constexpr T kMax = static_cast<T>((std::uint64_t{1} << Bits) - 1);
+    ser.adapter().writeBits(std::min(value, kMax), Bits);
+  }
+
+  template <typename Des, typename T, typename Fnc>
+  void deserialize(Des& des, T& value, Fnc&&) const {
+    des.adapter().readBits(value, Bits);
+  }
+};
+
+using WeaponModeBits = BoundedUInt<kWeaponModeBits>;
+using HeadDirectionBits = BoundedUInt<kHeadDirectionBits>;
+using SpellNrBits = BoundedUInt<kSpellNrBits>;
+
+}  // namespace Net
+
+namespace bitsery::traits {
+
+template <>
+struct ExtensionTraits<Net::QuantizedPosition, glm::vec3> {
+  using TValue = void;
+  static constexpr bool SupportValueOverload = false;
+  static constexpr bool SupportObjectOverload = true;
+  static constexpr bool SupportLambdaOverload = false;
+};
+
+template <>
+struct ExtensionTraits<Net::QuantizedNormal, glm::vec3> {
+  using TValue = void;
+  static constexpr bool SupportValueOverload = false;
+  static constexpr bool SupportObjectOverload = true;
+  static constexpr bool SupportLambdaOverload = false;
+};
+
+template <std::size_t Bits, typename T>
+struct ExtensionTraits<Net::BoundedUInt<Bits>, T> {
+  using TValue = void;
+  static constexpr bool SupportValueOverload = false;
+  static constexpr bool SupportObjectOverload = true;
+  static constexpr bool SupportLambdaOverload = false;
+};
+
+}  // namespace bitsery::traits
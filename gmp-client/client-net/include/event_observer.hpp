@@ -43,6 +43,8 @@ public:
   virtual void OnConnected() {}
   virtual void OnDisconnected() {}
   virtual void OnConnectionLost() {}
+  // The server is busy and queued the connection or the join request. 1-based position.
+  virtual void OnQueuePositionUpdate(std::uint16_t position, std::uint16_t queue_size) {}
   
   // World/map events
   virtual void OnMapChange(const std::string& map_name) {}
@@ -51,7 +53,11 @@ public:
   // Player events
   virtual void OnLocalPlayerJoined(gmp::client::Player& player) {}
   virtual void OnPlayerJoined(gmp::client::Player& player) {}
+  // Called once all players that were in game when the local player joined have been announced with OnPlayerJoined.
+  virtual void OnExistingPlayersReceived() {}
   virtual void OnPlayerLeft(std::uint64_t player_id, const std::string& player_name) {}
+  // Called for every snapshot before the state and position updates it carries, which all belong to this server time.
+  virtual void OnSnapshotReceived(std::uint32_t server_tick, std::uint32_t server_time_ms) {}
   virtual void OnPlayerStateUpdate(std::uint64_t player_id, const PlayerState& state) {}
   virtual void OnPlayerPositionUpdate(std::uint64_t player_id, float x, float z) {}
   virtual void OnPlayerDied(std::uint64_t player_id) {}
@@ -25,14 +25,16 @@ SOFTWARE.
 
 #pragma once
 
+#include <array>
 #include <cstdint>
-#include <functional>
-#include <map>
+#include <optional>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "common_structs.h"
 #include "event_observer.hpp"
+#include "packet_registry.h"
 #include "players.hpp"
 #include "world.hpp"
 #include "znet_client.h"
@@ -41,6 +43,12 @@ namespace gmp::client {
 
 class GameClient : public Net::NetClient::PacketHandler {
 public:
+  // Server tick and clock of a snapshot, the clock in milliseconds since the server started.
+  struct ServerTime {
+    std::uint32_t tick{0};
+    std::uint32_t time_ms{0};
+  };
+
   GameClient(EventObserver& eventObserver);
   ~GameClient();
 
@@ -49,6 +57,16 @@ public:
   bool IsConnected() const;
   int GetPing();
 
+  // Time of the newest snapshot received so far, zero before the first one.
+  const ServerTime& GetLastSnapshotTime() const {
+    return last_snapshot_time_;
+  }
+
+  // Current server clock, estimated from the snapshot timestamps and the ping. It follows the local
+  // clock between snapshots and only slowly absorbs jitter, so it is a stable timeline to interpolate
+  // remote players on, e.g. at this time minus a couple of ticks. 0 before the first snapshot.
+  std::uint32_t GetEstimatedServerTimeMs() const;
+
   // To be called after connecting to the server and receiving the initial info packet,
   // downloading all the required files, and loading the world.
   void JoinGame(const std::string& player_name, const std::string& character_name, int head_model, int skin_texture, int face_texture,
@@ -81,43 +99,50 @@ public:
   }
 
 private:
-  struct Packet {
-    unsigned char* data = nullptr;
-    std::uint32_t length = 0;
+  // State of a player as received in a given snapshot, used to resolve delta entries.
+  struct SnapshotBaseline {
+    std::uint16_t sequence{0};
+    bool valid{false};
+    PlayerState state;
   };
+  using SnapshotBaselineRing = std::array<SnapshotBaseline, kSnapshotBaselineWindow>;
 
-  void InitPacketHandlers();
   bool HandlePacket(unsigned char* data, std::uint32_t size) override;
   
   // Helper to update player state from PlayerState struct
   void UpdatePlayerState(Player* player, const PlayerState& state);
+  void UpdateServerClock(const ServerTime& time);
   
-  // Packet handlers
-  void OnInitialInfo(Packet packet);
-  void OnActualStatistics(Packet packet);
-  void OnMapOnly(Packet packet);
-  void OnDoDie(Packet packet);
-  void OnRespawn(Packet packet);
-  void OnCastSpell(Packet packet);
-  void OnCastSpellOnTarget(Packet packet);
-  void OnDropItem(Packet packet);
-  void OnTakeItem(Packet packet);
-  void OnWhisper(Packet packet);
-  void OnMessage(Packet packet);
-  void OnServerMessage(Packet packet);
-  void OnRcon(Packet packet);
-  void OnExistingPlayers(Packet packet);
-  void OnJoinGame(Packet packet);
-  void OnGameInfo(Packet packet);
-  void OnLeftGame(Packet packet);
-  void OnDiscordActivity(Packet packet);
-  void OnDisconnectOrLostConnection(Packet packet);
+  // Packet handlers, bound to their packet ids in HandlePacket. They get the packet already decoded as registered in packet_registry.h.
+  void OnInitialInfo(InitialInfoPacket& packet);
+  void OnActualStatistics(PlayerStateUpdatePacket& packet);
+  void OnMapOnly(PlayerPositionUpdatePacket& packet);
+  void OnSnapshot(SnapshotPacket& packet);
+  void OnDoDie(PlayerDeathInfoPacket& packet);
+  void OnRespawn(PlayerRespawnInfoPacket& packet);
+  void OnCastSpell(CastSpellPacket& packet);
+  void OnCastSpellOnTarget(CastSpellPacket& packet);
+  void OnDropItem(DropItemPacket& packet);
+  void OnTakeItem(TakeItemPacket& packet);
+  void OnWhisper(MessagePacket& packet);
+  void OnMessage(MessagePacket& packet);
+  void OnServerMessage(MessagePacket& packet);
+  bool OnRcon(Net::RawPacket& packet);
+  void OnExistingPlayers(ExistingPlayersPacket& packet);
+  void OnJoinGame(JoinGamePacket& packet);
+  void OnGameInfo(GameInfoPacket& packet);
+  void OnLeftGame(DisconnectionInfoPacket& packet);
+  void OnDiscordActivity(DiscordActivityPacket& packet);
+  void OnQueuePosition(QueuePositionPacket& packet);
+  void OnDisconnectOrLostConnection(Net::RawPacket& packet);
 
   EventObserver& event_observer_;
   PlayerManager player_manager_;
 
-  using PacketHandlerFunc = std::function<void(Packet)>;
-  std::map<int, PacketHandlerFunc> packet_handlers_;
+  std::unordered_map<std::uint64_t, SnapshotBaselineRing> snapshot_baselines_;
+  ServerTime last_snapshot_time_{};
+  // Server clock minus the local steady clock, in milliseconds. Empty until the first snapshot.
+  std::optional<double> server_clock_offset_ms_;
   std::vector<World> worlds_;
 
   std::string server_ip_;
@@ -110,11 +110,11 @@ bool RakNetClient::IsConnected() const {
   return isConnected_;
 }
 
-bool RakNetClient::SendPacket(unsigned char* data, std::uint32_t size, PacketReliability packetReliability,
-                              PacketPriority packetPriority) {
+bool RakNetClient::SendPacket(unsigned char* data, std::uint32_t size, PacketReliability packetReliability, PacketPriority packetPriority,
+                              std::uint32_t channel) {
   // TODO: VALIDATION AND ENCRYPTION.
   peer_->Send(reinterpret_cast<const char*>(data), size, ToRakNetPacketPriority(packetPriority),
-              ToRakNetPacketReliability(packetReliability), 0, serverAddress_, false);
+              ToRakNetPacketReliability(packetReliability), static_cast<char>(channel), serverAddress_, false);
   return true;
 }
 
@@ -41,8 +41,8 @@ public:
   bool Connect(const char* address, std::uint32_t port) override;
   void Disconnect() override;
   bool IsConnected() const override;
-  bool SendPacket(unsigned char* data, std::uint32_t size, PacketReliability packetReliability,
-                  PacketPriority packetPriority) override;
+  bool SendPacket(unsigned char* data, std::uint32_t size, PacketReliability packetReliability, PacketPriority packetPriority,
+                  std::uint32_t channel) override;
 
   void AddPacketHandler(PacketHandler& packetHandler) override;
   void RemovePacketHandler(PacketHandler& packetHandler) override;
@@ -49,7 +49,9 @@ public:
   virtual void Disconnect() = 0;
   virtual bool IsConnected() const = 0;
 
-  virtual bool SendPacket(unsigned char* data, std::uint32_t size, PacketReliability packetReliability, PacketPriority packetPriority) = 0;
+  // `channel` is the ordering channel, below 32. Ordered packets only wait for earlier packets on the same channel.
+  virtual bool SendPacket(unsigned char* data, std::uint32_t size, PacketReliability packetReliability, PacketPriority packetPriority,
+                          std::uint32_t channel) = 0;
 
   virtual void AddPacketHandler(PacketHandler& packetHandler) = 0;
   virtual void RemovePacketHandler(PacketHandler& packetHandler) = 0;
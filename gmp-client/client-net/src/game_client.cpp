@@ -30,10 +30,13 @@ SOFTWARE.
 #include <spdlog/spdlog.h>
 
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <dylib.hpp>
 #include <sstream>
 
 #include "net_enums.h"
+#include "packet_registry.h"
 #include "packets.h"
 #include "znet_client.h"
 
@@ -43,16 +46,31 @@ using namespace Net;
 
 static Net::NetClient* g_netclient = nullptr;
 
+// Share of the difference between a new clock sample and the estimate that is applied per snapshot.
+static constexpr double kServerClockSmoothing = 1.0 / 16.0;
+// Errors above this are not jitter but e.g. a server restart, so the estimate jumps instead.
+static constexpr double kServerClockResyncMs = 500.0;
+
+static double GetLocalTimeMs() {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 template <typename TContainer = std::vector<std::uint8_t>, typename Packet>
-static void SerializeAndSend(const Packet& packet, Net::PacketPriority priority, Net::PacketReliability reliable) {
+static void SerializeAndSend(const Packet& packet, Net::PacketPriority priority, Net::PacketReliability reliable, std::uint32_t channel) {
   TContainer buffer;
   auto written_size = bitsery::quickSerialization<bitsery::OutputBufferAdapter<TContainer>>(buffer, packet);
-  g_netclient->SendPacket(buffer.data(), written_size, reliable, priority);
+  g_netclient->SendPacket(buffer.data(), written_size, reliable, priority, channel);
+}
+
+// Sends with the delivery registered for the packet id, see packet_registry.h.
+template <Net::PacketID Id>
+static void SerializeAndSend(const typename Net::PacketDef<Net::PacketDirection::kToServer, Id>::Type& packet) {
+  constexpr auto kTraits = Net::PacketDef<Net::PacketDirection::kToServer, Id>::kTraits;
+  SerializeAndSend(packet, kTraits.priority, kTraits.reliability, kTraits.channel);
 }
 
 GameClient::GameClient(EventObserver& eventObserver) : event_observer_(eventObserver) {
   assert(g_netclient != nullptr);
-  InitPacketHandlers();
   g_netclient->AddPacketHandler(*this);
 }
 
@@ -61,29 +79,6 @@ GameClient::~GameClient() {
   g_netclient->RemovePacketHandler(*this);
 }
 
-void GameClient::InitPacketHandlers() {
-  packet_handlers_[PT_INITIAL_INFO] = [this](Packet p) { OnInitialInfo(p); };
-  packet_handlers_[PT_ACTUAL_STATISTICS] = [this](Packet p) { OnActualStatistics(p); };
-  packet_handlers_[PT_MAP_ONLY] = [this](Packet p) { OnMapOnly(p); };
-  packet_handlers_[PT_DODIE] = [this](Packet p) { OnDoDie(p); };
-  packet_handlers_[PT_RESPAWN] = [this](Packet p) { OnRespawn(p); };
-  packet_handlers_[PT_CASTSPELL] = [this](Packet p) { OnCastSpell(p); };
-  packet_handlers_[PT_CASTSPELLONTARGET] = [this](Packet p) { OnCastSpellOnTarget(p); };
-  packet_handlers_[PT_DROPITEM] = [this](Packet p) { OnDropItem(p); };
-  packet_handlers_[PT_TAKEITEM] = [this](Packet p) { OnTakeItem(p); };
-  packet_handlers_[PT_WHISPER] = [this](Packet p) { OnWhisper(p); };
-  packet_handlers_[PT_MSG] = [this](Packet p) { OnMessage(p); };
-  packet_handlers_[PT_SRVMSG] = [this](Packet p) { OnServerMessage(p); };
-  packet_handlers_[PT_COMMAND] = [this](Packet p) { OnRcon(p); };
-  packet_handlers_[PT_EXISTING_PLAYERS] = [this](Packet p) { OnExistingPlayers(p); };
-  packet_handlers_[PT_JOIN_GAME] = [this](Packet p) { OnJoinGame(p); };
-  packet_handlers_[PT_GAME_INFO] = [this](Packet p) { OnGameInfo(p); };
-  packet_handlers_[PT_LEFT_GAME] = [this](Packet p) { OnLeftGame(p); };
-  packet_handlers_[PT_DISCORD_ACTIVITY] = [this](Packet p) { OnDiscordActivity(p); };
-  packet_handlers_[Net::ID_DISCONNECTION_NOTIFICATION] = [this](Packet p) { OnDisconnectOrLostConnection(p); };
-  packet_handlers_[Net::ID_CONNECTION_LOST] = [this](Packet p) { OnDisconnectOrLostConnection(p); };
-}
-
 bool GameClient::Connect(std::string_view full_address) {
   // Extract port number from IP address if present
   std::string host(full_address);
@@ -121,6 +116,29 @@ int GameClient::GetPing() {
   return g_netclient->GetPing();
 }
 
+std::uint32_t GameClient::GetEstimatedServerTimeMs() const {
+  if (!server_clock_offset_ms_) {
+    return 0;
+  }
+  return static_cast<std::uint32_t>(static_cast<std::int64_t>(GetLocalTimeMs() + *server_clock_offset_ms_));
+}
+
+void GameClient::UpdateServerClock(const ServerTime& time) {
+  // A snapshot that was overtaken by a newer one must not move the clock backwards.
+  if (server_clock_offset_ms_ && static_cast<std::int32_t>(time.time_ms - last_snapshot_time_.time_ms) < 0) {
+    return;
+  }
+  last_snapshot_time_ = time;
+
+  // The snapshot was built about half a round trip ago.
+  const double sample = time.time_ms + std::max(GetPing(), 0) / 2.0 - GetLocalTimeMs();
+  if (!server_clock_offset_ms_ || std::abs(sample - *server_clock_offset_ms_) > kServerClockResyncMs) {
+    server_clock_offset_ms_ = sample;
+    return;
+  }
+  *server_clock_offset_ms_ += (sample - *server_clock_offset_ms_) * kServerClockSmoothing;
+}
+
 void GameClient::HandleNetwork() {
   if (IsConnected()) {
     g_netclient->Pulse();
@@ -128,13 +146,37 @@ void GameClient::HandleNetwork() {
 }
 
 bool GameClient::HandlePacket(unsigned char* data, std::uint32_t size) {
+  static constexpr auto kDispatcher = PacketDispatcher<PacketDirection::kToClient, GameClient>::Make(
+      PacketRoute<PT_INITIAL_INFO, &GameClient::OnInitialInfo>{}, PacketRoute<PT_ACTUAL_STATISTICS, &GameClient::OnActualStatistics>{},
+      PacketRoute<PT_MAP_ONLY, &GameClient::OnMapOnly>{}, PacketRoute<PT_SNAPSHOT, &GameClient::OnSnapshot>{},
+      PacketRoute<PT_DODIE, &GameClient::OnDoDie>{}, PacketRoute<PT_RESPAWN, &GameClient::OnRespawn>{},
+      PacketRoute<PT_CASTSPELL, &GameClient::OnCastSpell>{}, PacketRoute<PT_CASTSPELLONTARGET, &GameClient::OnCastSpellOnTarget>{},
+      PacketRoute<PT_DROPITEM, &GameClient::OnDropItem>{}, PacketRoute<PT_TAKEITEM, &GameClient::OnTakeItem>{},
+      PacketRoute<PT_WHISPER, &GameClient::OnWhisper>{}, PacketRoute<PT_MSG, &GameClient::OnMessage>{},
+      PacketRoute<PT_SRVMSG, &GameClient::OnServerMessage>{}, PacketRoute<PT_COMMAND, &GameClient::OnRcon>{},
+      PacketRoute<PT_EXISTING_PLAYERS, &GameClient::OnExistingPlayers>{}, PacketRoute<PT_JOIN_GAME, &GameClient::OnJoinGame>{},
+      PacketRoute<PT_GAME_INFO, &GameClient::OnGameInfo>{}, PacketRoute<PT_LEFT_GAME, &GameClient::OnLeftGame>{},
+      PacketRoute<PT_DISCORD_ACTIVITY, &GameClient::OnDiscordActivity>{}, PacketRoute<PT_QUEUE_POSITION, &GameClient::OnQueuePosition>{},
+      PacketRoute<ID_DISCONNECTION_NOTIFICATION, &GameClient::OnDisconnectOrLostConnection>{},
+      PacketRoute<ID_CONNECTION_LOST, &GameClient::OnDisconnectOrLostConnection>{});
+
+  const auto header = ReadPacketHeader(data, size);
+  if (!header) {
+    SPDLOG_WARN("Dropped packet of {} bytes without an id", size);
+    return true;
+  }
+
   try {
-    SPDLOG_TRACE("Received packet: {}", (int)data[0]);
-    auto it = packet_handlers_.find((int)data[0]);
-    if (it != packet_handlers_.end()) {
-      it->second(Packet{data, size});
-    } else {
-      SPDLOG_WARN("No handler for packet type: {}", (int)data[0]);
+    SPDLOG_TRACE("Received packet: {}", (int)header->id);
+    switch (kDispatcher.Dispatch(*this, header->id, data + header->offset, size - header->offset)) {
+      case DispatchResult::kHandled:
+        break;
+      case DispatchResult::kUnhandled:
+        SPDLOG_WARN("No handler for packet type: {}", (int)header->id);
+        break;
+      case DispatchResult::kMalformed:
+        SPDLOG_ERROR("Dropped malformed {} of {} bytes", PacketIDToString(static_cast<PacketID>(header->id)), size - header->offset);
+        break;
     }
   } catch (std::exception& ex) {
     SPDLOG_ERROR("Exception thrown while handling packet: {}", ex.what());
@@ -175,39 +217,42 @@ void GameClient::JoinGame(const std::string& player_name, const std::string& cha
   packet.walk_style = walk_style;
   packet.player_name = player_name;
 
-  SerializeAndSend(packet, IMMEDIATE_PRIORITY, RELIABLE_ORDERED);
+  SerializeAndSend<PT_JOIN_GAME>(packet);
 }
 
 void GameClient::SendChatMessage(const std::string& msg) {
   MessagePacket packet;
   packet.packet_type = PT_MSG;
   packet.message = msg;
-  SerializeAndSend(packet, MEDIUM_PRIORITY, RELIABLE);
+  SerializeAndSend<PT_MSG>(packet);
 }
 
 void GameClient::SendWhisper(std::uint64_t recipient_id, const std::string& msg) {
   MessagePacket packet;
   packet.packet_type = PT_WHISPER;
   packet.message = msg;
-  packet.recipient = recipient_id;
-  SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE_ORDERED);
+  packet.recipient = static_cast<NetId>(recipient_id);
+  SerializeAndSend<PT_WHISPER>(packet);
 }
 
 void GameClient::SendCommand(const std::string& msg) {
   MessagePacket packet;
   packet.packet_type = PT_COMMAND;
   packet.message = msg;
-  SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE_ORDERED);
+  SerializeAndSend<PT_COMMAND>(packet);
 }
 
 void GameClient::SendCastSpell(std::uint64_t target_id, std::uint16_t spell_id) {
   CastSpellPacket packet;
   packet.spell_id = spell_id;
-  packet.packet_type = target_id ? PT_CASTSPELLONTARGET : PT_CASTSPELL;
   if (target_id) {
-    packet.target_id = target_id;
+    packet.packet_type = PT_CASTSPELLONTARGET;
+    packet.target_id = static_cast<NetId>(target_id);
+    SerializeAndSend<PT_CASTSPELLONTARGET>(packet);
+    return;
   }
-  SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE);
+  packet.packet_type = PT_CASTSPELL;
+  SerializeAndSend<PT_CASTSPELL>(packet);
 }
 
 void GameClient::SendDropItem(std::uint16_t instance, std::uint16_t amount) {
@@ -215,50 +260,42 @@ void GameClient::SendDropItem(std::uint16_t instance, std::uint16_t amount) {
   packet.packet_type = PT_DROPITEM;
   packet.item_instance = instance;
   packet.item_amount = amount;
-  SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE);
+  SerializeAndSend<PT_DROPITEM>(packet);
 }
 
 void GameClient::SendTakeItem(std::uint16_t instance) {
   TakeItemPacket packet;
   packet.packet_type = PT_TAKEITEM;
   packet.item_instance = instance;
-  SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE);
+  SerializeAndSend<PT_TAKEITEM>(packet);
 }
 
 void GameClient::UpdatePlayerStats(const PlayerState& state) {
   PlayerStateUpdatePacket packet;
   packet.packet_type = PT_ACTUAL_STATISTICS;
   packet.state = state;
-  SerializeAndSend(packet, IMMEDIATE_PRIORITY, RELIABLE_ORDERED);
+  SerializeAndSend<PT_ACTUAL_STATISTICS>(packet);
 }
 
 void GameClient::SendHPDiff(std::uint64_t player_id, std::int16_t diff) {
   HPDiffPacket packet;
   packet.packet_type = PT_HP_DIFF;
-  packet.player_id = player_id;
+  packet.player_id = static_cast<NetId>(player_id);
   packet.hp_difference = diff;
-  SerializeAndSend(packet, IMMEDIATE_PRIORITY, RELIABLE);
+  SerializeAndSend<PT_HP_DIFF>(packet);
 }
 
 void GameClient::SyncGameTime() {
+  constexpr auto kTraits = PacketDef<PacketDirection::kToServer, PT_GAME_INFO>::kTraits;
   std::uint8_t data[2] = {PT_GAME_INFO, 0};
-  g_netclient->SendPacket(data, 1, RELIABLE, IMMEDIATE_PRIORITY);
+  g_netclient->SendPacket(data, 1, kTraits.reliability, kTraits.priority, kTraits.channel);
 }
 
 // ============================================================================
 // Packet Handlers
 // ============================================================================
 
-void GameClient::OnInitialInfo(Packet p) {
-  InitialInfoPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
-  if (!state.second) {
-    SPDLOG_ERROR("Failed to deserialize InitialInfoPacket, error code: {}", static_cast<int>(state.first));
-    return;
-  }
-
+void GameClient::OnInitialInfo(InitialInfoPacket& packet) {
   auto local_player = player_manager_.CreateLocalPlayer(packet.player_id);
   worlds_.clear();
   worlds_.emplace_back(packet.map_name);
@@ -267,16 +304,7 @@ void GameClient::OnInitialInfo(Packet p) {
   event_observer_.OnLocalPlayerJoined(*local_player);
 }
 
-void GameClient::OnActualStatistics(Packet p) {
-  PlayerStateUpdatePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
-  if (!state.second) {
-    SPDLOG_ERROR("Failed to deserialize PlayerStateUpdatePacket");
-    return;
-  }
-
+void GameClient::OnActualStatistics(PlayerStateUpdatePacket& packet) {
   SPDLOG_TRACE("PlayerStateUpdatePacket: {}", packet);
 
   if (!packet.player_id) {
@@ -293,11 +321,7 @@ void GameClient::OnActualStatistics(Packet p) {
   event_observer_.OnPlayerStateUpdate(*packet.player_id, packet.state);
 }
 
-void GameClient::OnMapOnly(Packet p) {
-  PlayerPositionUpdatePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnMapOnly(PlayerPositionUpdatePacket& packet) {
   if (!packet.player_id) {
     SPDLOG_ERROR("PlayerPositionUpdatePacket: Player id is null");
     return;
@@ -306,27 +330,63 @@ void GameClient::OnMapOnly(Packet p) {
   event_observer_.OnPlayerPositionUpdate(*packet.player_id, packet.position.x, packet.position.z);
 }
 
-void GameClient::OnDoDie(Packet p) {
-  PlayerDeathInfoPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
+void GameClient::OnSnapshot(SnapshotPacket& packet) {
+  SPDLOG_TRACE("SnapshotPacket: {}", packet);
 
-  event_observer_.OnPlayerDied(packet.player_id);
+  UpdateServerClock(ServerTime{packet.server_tick, packet.server_time_ms});
+  event_observer_.OnSnapshotReceived(packet.server_tick, packet.server_time_ms);
+
+  // Only acknowledge snapshots that were fully applied, the server uses every state in them as a baseline.
+  bool complete = true;
+  const std::uint16_t slot = packet.sequence % kSnapshotBaselineWindow;
+
+  // Unpack into the same callbacks as the separate PT_ACTUAL_STATISTICS and PT_MAP_ONLY packets.
+  for (const auto& entry : packet.player_states) {
+    SnapshotBaselineRing& baselines = snapshot_baselines_[entry.player_id];
+    PlayerState resolved_state = entry.state;
+
+    if (entry.baseline_age != 0) {
+      const std::uint16_t baseline_sequence = packet.sequence - entry.baseline_age;
+      const SnapshotBaseline& baseline = baselines[baseline_sequence % kSnapshotBaselineWindow];
+      if (!baseline.valid || baseline.sequence != baseline_sequence) {
+        SPDLOG_WARN("Missing baseline {} for player {} in snapshot {}", baseline_sequence, entry.player_id, packet.sequence);
+        complete = false;
+        continue;
+      }
+      resolved_state = baseline.state;
+      CopyPlayerStateFields(entry.state, resolved_state, entry.changed_fields);
+    }
+
+    baselines[slot] = SnapshotBaseline{packet.sequence, true, resolved_state};
+
+    Player* player = player_manager_.GetPlayer(entry.player_id);
+    if (player) {
+      UpdatePlayerState(player, resolved_state);
+    }
+    event_observer_.OnPlayerStateUpdate(entry.player_id, resolved_state);
+  }
+
+  for (const auto& entry : packet.player_positions) {
+    event_observer_.OnPlayerPositionUpdate(entry.player_id, entry.position.x, entry.position.z);
+  }
+
+  if (complete) {
+    SnapshotAckPacket ack;
+    ack.packet_type = PT_SNAPSHOT_ACK;
+    ack.sequence = packet.sequence;
+    SerializeAndSend<PT_SNAPSHOT_ACK>(ack);
+  }
 }
 
-void GameClient::OnRespawn(Packet p) {
-  PlayerRespawnInfoPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
+void GameClient::OnDoDie(PlayerDeathInfoPacket& packet) {
+  event_observer_.OnPlayerDied(packet.player_id);
+}
 
+void GameClient::OnRespawn(PlayerRespawnInfoPacket& packet) {
   event_observer_.OnPlayerRespawned(packet.player_id);
 }
 
-void GameClient::OnCastSpell(Packet p) {
-  CastSpellPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnCastSpell(CastSpellPacket& packet) {
   if (!packet.caster_id) {
     SPDLOG_ERROR("CastSpellPacket Caster ID is null");
     return;
@@ -335,11 +395,7 @@ void GameClient::OnCastSpell(Packet p) {
   event_observer_.OnSpellCast(*packet.caster_id, packet.spell_id);
 }
 
-void GameClient::OnCastSpellOnTarget(Packet p) {
-  CastSpellPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnCastSpellOnTarget(CastSpellPacket& packet) {
   if (!packet.caster_id || !packet.target_id) {
     SPDLOG_ERROR("Invalid CastSpellOnTarget packet. No caster or target id.");
     return;
@@ -348,11 +404,7 @@ void GameClient::OnCastSpellOnTarget(Packet p) {
   event_observer_.OnSpellCastOnTarget(*packet.caster_id, *packet.target_id, packet.spell_id);
 }
 
-void GameClient::OnDropItem(Packet p) {
-  DropItemPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnDropItem(DropItemPacket& packet) {
   if (!packet.player_id) {
     SPDLOG_ERROR("Invalid DropItem packet. No player id.");
     return;
@@ -361,11 +413,7 @@ void GameClient::OnDropItem(Packet p) {
   event_observer_.OnItemDropped(*packet.player_id, packet.item_instance, packet.item_amount);
 }
 
-void GameClient::OnTakeItem(Packet p) {
-  TakeItemPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnTakeItem(TakeItemPacket& packet) {
   if (!packet.player_id) {
     SPDLOG_ERROR("Invalid TakeItem packet. No player id.");
     return;
@@ -374,11 +422,7 @@ void GameClient::OnTakeItem(Packet p) {
   event_observer_.OnItemTaken(*packet.player_id, packet.item_instance);
 }
 
-void GameClient::OnWhisper(Packet p) {
-  MessagePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnWhisper(MessagePacket& packet) {
   if (!packet.sender) {
     SPDLOG_ERROR("Invalid Message packet. No sender id.");
     return;
@@ -389,11 +433,7 @@ void GameClient::OnWhisper(Packet p) {
   event_observer_.OnWhisperReceived(*packet.sender, sender_name, packet.message);
 }
 
-void GameClient::OnMessage(Packet p) {
-  MessagePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnMessage(MessagePacket& packet) {
   if (!packet.sender) {
     SPDLOG_ERROR("Invalid Message packet. No sender id.");
     return;
@@ -406,25 +446,22 @@ void GameClient::OnMessage(Packet p) {
   event_observer_.OnChatMessage(*packet.sender, sender_name, packet.message);
 }
 
-void GameClient::OnServerMessage(Packet p) {
-  MessagePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnServerMessage(MessagePacket& packet) {
   event_observer_.OnServerMessage(packet.message);
 }
 
-void GameClient::OnRcon(Packet p) {
-  bool is_admin = (p.data[1] == 0x41);
-  std::string response((char*)p.data + 1);
+bool GameClient::OnRcon(Net::RawPacket& packet) {
+  // The packet id followed by the response text, which is not null-terminated.
+  if (packet.size < 2) {
+    return false;
+  }
+  bool is_admin = (packet.data[1] == 0x41);
+  std::string response(reinterpret_cast<char*>(packet.data) + 1, packet.size - 1);
   event_observer_.OnRconResponse(response, is_admin);
+  return true;
 }
 
-void GameClient::OnExistingPlayers(Packet p) {
-  ExistingPlayersPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnExistingPlayers(ExistingPlayersPacket& packet) {
   for (const auto& existing_player : packet.existing_players) {
     SPDLOG_INFO("ExistingPlayerPacket packet: {}", existing_player);
 
@@ -443,13 +480,14 @@ void GameClient::OnExistingPlayers(Packet p) {
 
     event_observer_.OnPlayerJoined(*player);
   }
-}
 
-void GameClient::OnJoinGame(Packet p) {
-  JoinGamePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
+  if (packet.last_page) {
+    SPDLOG_INFO("Received all existing players in {} pages", packet.page + 1);
+    event_observer_.OnExistingPlayersReceived();
+  }
+}
 
+void GameClient::OnJoinGame(JoinGamePacket& packet) {
   if (!packet.player_id) {
     SPDLOG_ERROR("Invalid JoinGame packet. No player id.");
     return;
@@ -473,19 +511,11 @@ void GameClient::OnJoinGame(Packet p) {
   event_observer_.OnPlayerJoined(*player);
 }
 
-void GameClient::OnGameInfo(Packet p) {
-  GameInfoPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnGameInfo(GameInfoPacket& packet) {
   event_observer_.OnGameInfoReceived(packet.raw_game_time, packet.flags);
 }
 
-void GameClient::OnLeftGame(Packet p) {
-  DisconnectionInfoPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnLeftGame(DisconnectionInfoPacket& packet) {
   // Get player name before removing
   Player* player = player_manager_.GetPlayer(packet.disconnected_id);
   std::string player_name = player ? player->name() : "";
@@ -494,21 +524,23 @@ void GameClient::OnLeftGame(Packet p) {
   
   // Remove from player manager
   player_manager_.RemovePlayer(packet.disconnected_id);
+  snapshot_baselines_.erase(packet.disconnected_id);
 }
 
-void GameClient::OnDiscordActivity(Packet p) {
-  DiscordActivityPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+void GameClient::OnDiscordActivity(DiscordActivityPacket& packet) {
   SPDLOG_DEBUG("DiscordActivityPacket: {}", packet);
 
   event_observer_.OnDiscordActivityUpdate(packet.state, packet.details, packet.large_image_key, packet.large_image_text,
                                          packet.small_image_key, packet.small_image_text);
 }
 
-void GameClient::OnDisconnectOrLostConnection(Packet p) {
-  SPDLOG_WARN("OnDisconnectOrLostConnection, code: {}", p.data[0]);
+void GameClient::OnQueuePosition(QueuePositionPacket& packet) {
+  SPDLOG_INFO("Waiting to be admitted by the server, position {} of {}", packet.position, packet.queue_size);
+  event_observer_.OnQueuePositionUpdate(packet.position, packet.queue_size);
+}
+
+void GameClient::OnDisconnectOrLostConnection(Net::RawPacket& packet) {
+  SPDLOG_WARN("OnDisconnectOrLostConnection, code: {}", packet.data[0]);
   connection_lost_ = true;
   is_in_game_ = false;
   event_observer_.OnConnectionLost();
@@ -0,0 +1,128 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <MessageIdentifiers.h>
+#include <RakPeerInterface.h>
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+constexpr unsigned short kSlots = 500;
+
+// A server with kSlots slots and one client connected over loopback.
+class LoopbackConnection {
+public:
+  LoopbackConnection() {
+    server_ = RakNet::RakPeerInterface::GetInstance();
+    client_ = RakNet::RakPeerInterface::GetInstance();
+
+    RakNet::SocketDescriptor server_socket{0, nullptr};
+    server_->Startup(kSlots, &server_socket, 1);
+    server_->SetMaximumIncomingConnections(kSlots);
+    const unsigned short port = server_->GetInternalID(RakNet::UNASSIGNED_SYSTEM_ADDRESS, 0).GetPort();
+
+    RakNet::SocketDescriptor client_socket{0, nullptr};
+    client_->Startup(1, &client_socket, 1);
+    client_->Connect("127.0.0.1", port, nullptr, 0);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!connected_ && std::chrono::steady_clock::now() < deadline) {
+      for (RakNet::Packet* packet = server_->Receive(); packet != nullptr; packet = server_->Receive()) {
+        if (packet->data[0] == ID_NEW_INCOMING_CONNECTION) {
+          guid_ = packet->guid;
+          connected_ = true;
+        }
+        server_->DeallocatePacket(packet);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  ~LoopbackConnection() {
+    client_->Shutdown(0);
+    server_->Shutdown(0);
+    RakNet::RakPeerInterface::DestroyInstance(client_);
+    RakNet::RakPeerInterface::DestroyInstance(server_);
+  }
+
+  RakNet::RakPeerInterface* server_{nullptr};
+  RakNet::RakPeerInterface* client_{nullptr};
+  RakNet::RakNetGUID guid_;
+  bool connected_{false};
+};
+
+LoopbackConnection& GetConnection() {
+  static LoopbackConnection connection;
+  return connection;
+}
+
+// What RakNetServer did before caching: a GUID rebuilt from the 64-bit handle, without its system index.
+// The client sits in the first slot, so this is the best case of the scan.
+void BM_LookupRebuiltGuid(benchmark::State& state) {
+  auto& connection = GetConnection();
+  if (!connection.connected_) {
+    state.SkipWithError("loopback connection failed");
+    return;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(connection.server_->GetSystemAddressFromGuid(RakNet::RakNetGUID(connection.guid_.g)));
+  }
+}
+
+// A GUID missing from the slot list is compared against all kSlots slots, as is a player in the last slot.
+void BM_LookupRebuiltGuidWorstCase(benchmark::State& state) {
+  auto& connection = GetConnection();
+  if (!connection.connected_) {
+    state.SkipWithError("loopback connection failed");
+    return;
+  }
+  const RakNet::RakNetGUID missing(connection.guid_.g + 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(connection.server_->GetSystemAddressFromGuid(missing));
+  }
+}
+
+// The GUID cached by RakNetServer, whose system index lets RakPeer go straight to the slot.
+void BM_LookupCachedGuid(benchmark::State& state) {
+  auto& connection = GetConnection();
+  if (!connection.connected_) {
+    state.SkipWithError("loopback connection failed");
+    return;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(connection.server_->GetSystemAddressFromGuid(connection.guid_));
+  }
+}
+
+BENCHMARK(BM_LookupRebuiltGuid);
+BENCHMARK(BM_LookupRebuiltGuidWorstCase);
+BENCHMARK(BM_LookupCachedGuid);
+
+}  // namespace
+
+BENCHMARK_MAIN();
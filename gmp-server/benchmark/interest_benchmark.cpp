@@ -0,0 +1,147 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "spatial_grid.h"
+
+namespace {
+
+constexpr float kRadius = 5000.0f;
+constexpr float kWorldHalfExtent = 40000.0f;
+
+struct SimulatedPlayer {
+  std::uint32_t player_id;
+  glm::vec3 position;
+};
+
+std::vector<SimulatedPlayer> MakePlayers(std::size_t count) {
+  std::mt19937 rng(1337);
+  std::uniform_real_distribution<float> horizontal(-kWorldHalfExtent, kWorldHalfExtent);
+  std::uniform_real_distribution<float> vertical(-1000.0f, 3000.0f);
+
+  std::vector<SimulatedPlayer> players;
+  players.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    players.push_back({static_cast<std::uint32_t>(i + 1), glm::vec3(horizontal(rng), vertical(rng), horizontal(rng))});
+  }
+  return players;
+}
+
+// Mirrors the pairwise distance map GameServer::Run used to build every tick.
+void BM_PairwiseDistanceMap(benchmark::State& state) {
+  auto players = MakePlayers(static_cast<std::size_t>(state.range(0)));
+
+  using PlayersKey = std::pair<std::uint32_t, std::uint32_t>;
+  struct PlayersKeyHash {
+    std::size_t operator()(const PlayersKey& key) const {
+      std::hash<uint64_t> hasher;
+      return hasher(key.first) ^ (hasher(key.second) << 1);
+    }
+  };
+
+  for (auto _ : state) {
+    std::unordered_map<PlayersKey, float, PlayersKeyHash> distances;
+    distances.reserve((players.size() * (players.size() - 1)) / 2);
+    for (std::size_t i = 0; i < players.size(); ++i) {
+      for (std::size_t j = i + 1; j < players.size(); ++j) {
+        distances[{players[i].player_id, players[j].player_id}] = glm::distance(players[i].position, players[j].position);
+      }
+    }
+
+    std::size_t near_pairs = 0;
+    std::size_t far_pairs = 0;
+    for (const auto& [key, distance] : distances) {
+      if (distance < kRadius) {
+        ++near_pairs;
+      } else {
+        ++far_pairs;
+      }
+    }
+    benchmark::DoNotOptimize(near_pairs);
+    benchmark::DoNotOptimize(far_pairs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Same classification through the spatial grid, including re-bucketing every player once per tick.
+void BM_SpatialGrid(benchmark::State& state) {
+  auto players = MakePlayers(static_cast<std::size_t>(state.range(0)));
+  SpatialGrid grid(kRadius);
+  for (const auto& player : players) {
+    grid.Update(player.player_id, player.position);
+  }
+
+  std::unordered_map<std::uint32_t, std::size_t> indices;
+  for (std::size_t i = 0; i < players.size(); ++i) {
+    indices.emplace(players[i].player_id, i);
+  }
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> step(-50.0f, 50.0f);
+  constexpr float kRadiusSquared = kRadius * kRadius;
+
+  for (auto _ : state) {
+    for (auto& player : players) {
+      player.position.x += step(rng);
+      player.position.z += step(rng);
+      grid.Update(player.player_id, player.position);
+    }
+
+    std::size_t near_pairs = 0;
+    std::size_t far_pairs = 0;
+    for (std::size_t i = 0; i < players.size(); ++i) {
+      std::size_t near_for_observer = 0;
+      grid.ForEachNeighbour(players[i].position, [&](std::uint32_t candidate_id) {
+        const auto& candidate = players[indices[candidate_id]];
+        if (candidate.player_id == players[i].player_id) {
+          return;
+        }
+        const glm::vec3 offset = candidate.position - players[i].position;
+        if (glm::dot(offset, offset) < kRadiusSquared) {
+          ++near_for_observer;
+        }
+      });
+      near_pairs += near_for_observer;
+      far_pairs += players.size() - 1 - near_for_observer;
+    }
+    benchmark::DoNotOptimize(near_pairs);
+    benchmark::DoNotOptimize(far_pairs);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PairwiseDistanceMap)->Arg(50)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SpatialGrid)->Arg(50)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,156 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "net_enums.h"
+#include "packets.h"
+#include "player_manager.h"
+#include "send_buffer_pool.h"
+#include "spawn_record_cache.h"
+
+namespace {
+
+using Player = PlayerManager::Player;
+
+// Page size limit of GameServer::SendExistingPlayers.
+constexpr std::size_t kPageSize = 1200;
+
+void Populate(PlayerManager& manager, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& player = manager.GetPlayer(manager.AddPlayer(i + 1, "Player" + std::to_string(i)))->get();
+    player.is_ingame = 1;
+    player.state.position = glm::vec3(static_cast<float>(i) * 100.0f, 0.0f, static_cast<float>(i) * -100.0f);
+    player.state.equipped_armor_instance = static_cast<std::int16_t>(i);
+  }
+}
+
+// Every player joins at once, e.g. right after a restart, and gets all the others. This is the join burst the
+// way it was built before the spawn record cache: an ExistingPlayerInfo per player, serialized per joining client.
+void BM_JoinBurstRebuilt(benchmark::State& state) {
+  PlayerManager manager;
+  Populate(manager, static_cast<std::size_t>(state.range(0)));
+  auto& pool = SendBufferPool::ForCurrentThread();
+
+  for (auto _ : state) {
+    std::size_t sent_bytes = 0;
+    for (const Player& joining_player : manager.GetAllPlayers()) {
+      ExistingPlayersPacket page;
+      page.packet_type = Net::PT_EXISTING_PLAYERS;
+      std::size_t page_size = kExistingPlayersPacketHeaderSize;
+      auto send_page = [&]() {
+        sent_bytes += pool.Serialize(page, kPageSize).second;
+        ++page.page;
+        page.existing_players.clear();
+        page_size = kExistingPlayersPacketHeaderSize;
+      };
+
+      for (const Player& existing_player : manager.GetAllPlayers()) {
+        if (existing_player.player_id == joining_player.player_id) {
+          continue;
+        }
+        const auto& info = manager.GetInfo(existing_player);
+        const std::size_t entry_size = GetExistingPlayerInfoSize(info.name.size());
+        if (!page.existing_players.empty() && page_size + entry_size > kPageSize) {
+          send_page();
+        }
+        ExistingPlayerInfo& player_packet = page.existing_players.emplace_back();
+        player_packet.player_id = existing_player.net_id;
+        player_packet.position = existing_player.state.position;
+        player_packet.left_hand_item_instance = existing_player.state.left_hand_item_instance;
+        player_packet.right_hand_item_instance = existing_player.state.right_hand_item_instance;
+        player_packet.equipped_armor_instance = existing_player.state.equipped_armor_instance;
+        player_packet.head_model = info.head;
+        player_packet.skin_texture = info.skin;
+        player_packet.face_texture = info.body;
+        player_packet.walk_style = info.walkstyle;
+        player_packet.player_name = info.name;
+        page_size += entry_size;
+      }
+      page.last_page = true;
+      send_page();
+    }
+    benchmark::DoNotOptimize(sent_bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The same burst gathered from cached spawn records, the way GameServer::SendExistingPlayers does it.
+void BM_JoinBurstCached(benchmark::State& state) {
+  PlayerManager manager;
+  Populate(manager, static_cast<std::size_t>(state.range(0)));
+  auto& pool = SendBufferPool::ForCurrentThread();
+  SpawnRecordCache cache;
+
+  for (auto _ : state) {
+    std::size_t sent_bytes = 0;
+    for (const Player& joining_player : manager.GetAllPlayers()) {
+      ExistingPlayersPageHeader header;
+      header.packet_type = Net::PT_EXISTING_PLAYERS;
+      header.last_page = false;
+      auto lease = pool.Acquire(kPageSize);
+      auto& buffer = lease.Get();
+      std::size_t page_size = kExistingPlayersPacketHeaderSize;
+      auto send_page = [&]() {
+        bitsery::quickSerialization<SendBufferPool::OutputAdapter>(buffer, header);
+        sent_bytes += page_size;
+        ++header.page;
+        header.count = 0;
+        page_size = kExistingPlayersPacketHeaderSize;
+      };
+
+      for (const Player& existing_player : manager.GetAllPlayers()) {
+        if (existing_player.player_id == joining_player.player_id) {
+          continue;
+        }
+        const auto record = cache.Get(existing_player, manager.GetInfo(existing_player));
+        if (header.count > 0 && page_size + record.size() > kPageSize) {
+          send_page();
+        }
+        if (buffer.size() < page_size + record.size()) {
+          buffer.resize(page_size + record.size());
+        }
+        std::memcpy(buffer.data() + page_size, record.data(), record.size());
+        page_size += record.size();
+        ++header.count;
+      }
+      header.last_page = true;
+      send_page();
+    }
+    benchmark::DoNotOptimize(sent_bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["rebuilds"] = static_cast<double>(cache.GetRebuildCount());
+}
+
+}  // namespace
+
+BENCHMARK(BM_JoinBurstRebuilt)->Arg(300)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JoinBurstCached)->Arg(300)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
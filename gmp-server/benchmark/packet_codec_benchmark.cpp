@@ -0,0 +1,321 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "common_structs.h"
+#include "net_enums.h"
+#include "packet_views.h"
+#include "packets.h"
+
+// Encode and decode cost and encoded size of every wire struct, one benchmark per struct and direction. The "bytes"
+// counter is the encoded size of the sample, so size regressions show up next to speed ones.
+
+namespace {
+
+using Buffer = std::vector<std::uint8_t>;
+using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
+using InputAdapter = bitsery::InputBufferAdapter<const std::uint8_t*>;
+
+PlayerState MakeState() {
+  PlayerState state;
+  state.position = glm::vec3(12345.0f, -678.0f, -23456.0f);
+  state.nrot = glm::normalize(glm::vec3(0.3f, 0.0f, 0.9f));
+  state.left_hand_item_instance = 5123;
+  state.right_hand_item_instance = 5124;
+  state.equipped_armor_instance = 6001;
+  state.animation = 312;
+  state.health_points = 87;
+  state.mana_points = 40;
+  state.weapon_mode = 3;
+  state.active_spell_nr = 12;
+  state.head_direction = 2;
+  state.melee_weapon_instance = 7001;
+  state.ranged_weapon_instance = 7002;
+  return state;
+}
+
+ExistingPlayerInfo MakeExistingPlayerInfo(NetId id) {
+  ExistingPlayerInfo info;
+  info.player_id = id;
+  info.selected_class = 2;
+  info.position = glm::vec3(1000.0f + id, 50.0f, -2000.0f);
+  info.left_hand_item_instance = 5123;
+  info.right_hand_item_instance = 5124;
+  info.equipped_armor_instance = 6001;
+  info.head_model = 3;
+  info.skin_texture = 9;
+  info.face_texture = 41;
+  info.walk_style = 1;
+  info.player_name = "Player" + std::to_string(id);
+  return info;
+}
+
+// A typical instance of each struct.
+template <typename T>
+T MakeSample();
+
+template <>
+PlayerState MakeSample<PlayerState>() {
+  return MakeState();
+}
+
+template <>
+ExistingPlayerInfo MakeSample<ExistingPlayerInfo>() {
+  return MakeExistingPlayerInfo(17);
+}
+
+template <>
+ExistingPlayersPacket MakeSample<ExistingPlayersPacket>() {
+  ExistingPlayersPacket packet;
+  packet.packet_type = Net::PT_EXISTING_PLAYERS;
+  for (NetId id = 1; id <= 40; ++id) {
+    packet.existing_players.push_back(MakeExistingPlayerInfo(id));
+  }
+  return packet;
+}
+
+template <>
+ExistingPlayersPageHeader MakeSample<ExistingPlayersPageHeader>() {
+  return ExistingPlayersPageHeader{Net::PT_EXISTING_PLAYERS, 3, false, 40};
+}
+
+template <>
+JoinGamePacket MakeSample<JoinGamePacket>() {
+  JoinGamePacket packet;
+  packet.packet_type = Net::PT_JOIN_GAME;
+  packet.selected_class = 2;
+  packet.position = glm::vec3(12345.0f, -678.0f, -23456.0f);
+  packet.normal = glm::normalize(glm::vec3(0.3f, 0.0f, 0.9f));
+  packet.left_hand_item_instance = 5123;
+  packet.right_hand_item_instance = 5124;
+  packet.equipped_armor_instance = 6001;
+  packet.animation = 312;
+  packet.head_model = 3;
+  packet.skin_texture = 9;
+  packet.face_texture = 41;
+  packet.walk_style = 1;
+  packet.player_name = "Xardas the Necromancer";
+  packet.player_id = 17;
+  return packet;
+}
+
+template <>
+MessagePacket MakeSample<MessagePacket>() {
+  MessagePacket packet;
+  packet.packet_type = Net::PT_MSG;
+  packet.message = "Anyone up for a trip to the Valley of Mines? Meet at the eastern gate of Khorinis.";
+  packet.sender = 17;
+  return packet;
+}
+
+template <>
+CastSpellPacket MakeSample<CastSpellPacket>() {
+  return CastSpellPacket{Net::PT_CASTSPELLONTARGET, 41, NetId{18}, NetId{17}};
+}
+
+template <>
+DropItemPacket MakeSample<DropItemPacket>() {
+  return DropItemPacket{Net::PT_DROPITEM, 5123, 25, NetId{17}};
+}
+
+template <>
+TakeItemPacket MakeSample<TakeItemPacket>() {
+  return TakeItemPacket{Net::PT_TAKEITEM, 5123, NetId{17}};
+}
+
+template <>
+PlayerStateUpdatePacket MakeSample<PlayerStateUpdatePacket>() {
+  return PlayerStateUpdatePacket{Net::PT_ACTUAL_STATISTICS, MakeState(), std::nullopt};
+}
+
+template <>
+PlayerPositionUpdatePacket MakeSample<PlayerPositionUpdatePacket>() {
+  return PlayerPositionUpdatePacket{Net::PT_MAP_ONLY, glm::vec3(12345.0f, -678.0f, -23456.0f), NetId{17}};
+}
+
+// A moving player, the common case in snapshots.
+template <>
+SnapshotPlayerState MakeSample<SnapshotPlayerState>() {
+  return SnapshotPlayerState{17, 1, PSF_POSITION | PSF_NROT | PSF_ANIMATION, MakeState()};
+}
+
+template <>
+SnapshotPlayerPosition MakeSample<SnapshotPlayerPosition>() {
+  return SnapshotPlayerPosition{17, glm::vec3(12345.0f, -678.0f, -23456.0f)};
+}
+
+template <>
+SnapshotPacket MakeSample<SnapshotPacket>() {
+  SnapshotPacket packet;
+  packet.packet_type = Net::PT_SNAPSHOT;
+  packet.sequence = 1234;
+  packet.server_tick = 56789;
+  packet.server_time_ms = 5678900;
+  for (NetId id = 1; id <= 32; ++id) {
+    auto entry = MakeSample<SnapshotPlayerState>();
+    entry.player_id = id;
+    packet.player_states.push_back(entry);
+  }
+  for (NetId id = 33; id <= 96; ++id) {
+    packet.player_positions.push_back(SnapshotPlayerPosition{id, glm::vec3(100.0f * id, 0.0f, -100.0f * id)});
+  }
+  return packet;
+}
+
+template <>
+SnapshotAckPacket MakeSample<SnapshotAckPacket>() {
+  return SnapshotAckPacket{Net::PT_SNAPSHOT_ACK, 1234};
+}
+
+template <>
+HPDiffPacket MakeSample<HPDiffPacket>() {
+  return HPDiffPacket{Net::PT_HP_DIFF, 18, -25};
+}
+
+template <>
+VoicePacket MakeSample<VoicePacket>() {
+  return VoicePacket{Net::PT_VOICE, 480, std::vector<std::uint8_t>(480, 0x5A)};
+}
+
+template <>
+DisconnectionInfoPacket MakeSample<DisconnectionInfoPacket>() {
+  return DisconnectionInfoPacket{Net::PT_LEFT_GAME, 17};
+}
+
+template <>
+PlayerDeathInfoPacket MakeSample<PlayerDeathInfoPacket>() {
+  return PlayerDeathInfoPacket{Net::PT_DODIE, 17};
+}
+
+template <>
+PlayerRespawnInfoPacket MakeSample<PlayerRespawnInfoPacket>() {
+  return PlayerRespawnInfoPacket{Net::PT_RESPAWN, 17};
+}
+
+template <>
+InitialInfoPacket MakeSample<InitialInfoPacket>() {
+  return InitialInfoPacket{Net::PT_INITIAL_INFO, "NEWWORLD\\NEWWORLD.ZEN", 17};
+}
+
+template <>
+QueuePositionPacket MakeSample<QueuePositionPacket>() {
+  return QueuePositionPacket{Net::PT_QUEUE_POSITION, 12, 40};
+}
+
+template <>
+GameInfoPacket MakeSample<GameInfoPacket>() {
+  return GameInfoPacket{Net::PT_GAME_INFO, 0x00123456, 0};
+}
+
+template <>
+DiscordActivityPacket MakeSample<DiscordActivityPacket>() {
+  return DiscordActivityPacket{Net::PT_DISCORD_ACTIVITY, "In the Valley of Mines", "12 of 100 players", "gmp_logo", "Gothic Multiplayer",
+                               "class_mage", "Fire Mage"};
+}
+
+Buffer Encode(const auto& packet) {
+  Buffer buffer;
+  buffer.resize(bitsery::quickSerialization<OutputAdapter>(buffer, packet));
+  return buffer;
+}
+
+template <typename T>
+void BM_Encode(benchmark::State& state) {
+  const T packet = MakeSample<T>();
+  Buffer buffer;
+  std::size_t size = 0;
+  for (auto _ : state) {
+    size = bitsery::quickSerialization<OutputAdapter>(buffer, packet);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+  state.counters["bytes"] = static_cast<double>(size);
+}
+
+template <typename T>
+void BM_Decode(benchmark::State& state) {
+  const Buffer buffer = Encode(MakeSample<T>());
+  T packet{};
+  for (auto _ : state) {
+    auto result = bitsery::quickDeserialization<InputAdapter>({buffer.data(), buffer.size()}, packet);
+    benchmark::DoNotOptimize(result);
+    benchmark::DoNotOptimize(packet);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * buffer.size()));
+  state.counters["bytes"] = static_cast<double>(buffer.size());
+}
+
+// Decoding into the view of T, which leaves strings in the buffer. Compare with BM_Decode<T>.
+template <typename T>
+void BM_DecodeView(benchmark::State& state) {
+  const Buffer buffer = Encode(MakeSample<T>());
+  typename Net::PacketViewOf<T>::Type view;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Net::DecodeView(buffer.data(), static_cast<std::uint32_t>(buffer.size()), view));
+    benchmark::DoNotOptimize(view);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * buffer.size()));
+  state.counters["bytes"] = static_cast<double>(buffer.size());
+}
+
+}  // namespace
+
+#define CODEC_BENCHMARK(T)        \
+  BENCHMARK_TEMPLATE(BM_Encode, T); \
+  BENCHMARK_TEMPLATE(BM_Decode, T)
+
+CODEC_BENCHMARK(PlayerState);
+CODEC_BENCHMARK(ExistingPlayerInfo);
+CODEC_BENCHMARK(ExistingPlayersPacket);
+CODEC_BENCHMARK(ExistingPlayersPageHeader);
+CODEC_BENCHMARK(JoinGamePacket);
+CODEC_BENCHMARK(MessagePacket);
+CODEC_BENCHMARK(CastSpellPacket);
+CODEC_BENCHMARK(DropItemPacket);
+CODEC_BENCHMARK(TakeItemPacket);
+CODEC_BENCHMARK(PlayerStateUpdatePacket);
+CODEC_BENCHMARK(PlayerPositionUpdatePacket);
+CODEC_BENCHMARK(SnapshotPlayerState);
+CODEC_BENCHMARK(SnapshotPlayerPosition);
+CODEC_BENCHMARK(SnapshotPacket);
+CODEC_BENCHMARK(SnapshotAckPacket);
+CODEC_BENCHMARK(HPDiffPacket);
+CODEC_BENCHMARK(VoicePacket);
+CODEC_BENCHMARK(DisconnectionInfoPacket);
+CODEC_BENCHMARK(PlayerDeathInfoPacket);
+CODEC_BENCHMARK(PlayerRespawnInfoPacket);
+CODEC_BENCHMARK(InitialInfoPacket);
+CODEC_BENCHMARK(QueuePositionPacket);
+CODEC_BENCHMARK(GameInfoPacket);
+CODEC_BENCHMARK(DiscordActivityPacket);
+BENCHMARK_TEMPLATE(BM_DecodeView, JoinGamePacket);
+BENCHMARK_TEMPLATE(BM_DecodeView, MessagePacket);
+
+BENCHMARK_MAIN();
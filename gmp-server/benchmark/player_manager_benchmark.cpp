@@ -0,0 +1,215 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "player_manager.h"
+
+namespace {
+
+using Player = PlayerManager::Player;
+using PlayerId = PlayerManager::PlayerId;
+
+// The hash map based PlayerManager this one replaced, reduced to what is measured here.
+class HashMapPlayerManager {
+public:
+  PlayerId AddPlayer(Net::ConnectionHandle connection) {
+    const PlayerId player_id = next_player_id_++;
+    Player player{};
+    player.player_id = player_id;
+    player.connection = connection;
+    players_[player_id] = std::move(player);
+    player_to_connection_[player_id] = connection;
+    connection_to_player_[connection] = player_id;
+    return player_id;
+  }
+
+  bool RemovePlayer(PlayerId player_id) {
+    auto it = players_.find(player_id);
+    if (it == players_.end()) {
+      return false;
+    }
+    connection_to_player_.erase(it->second.connection);
+    player_to_connection_.erase(player_id);
+    players_.erase(it);
+    return true;
+  }
+
+  Player* GetPlayerByConnection(Net::ConnectionHandle connection) {
+    auto it = connection_to_player_.find(connection);
+    if (it == connection_to_player_.end()) {
+      return nullptr;
+    }
+    auto player_it = players_.find(it->second);
+    return player_it != players_.end() ? &player_it->second : nullptr;
+  }
+
+  template <typename Func>
+  void ForEachIngamePlayer(Func&& func) {
+    for (auto& [id, player] : players_) {
+      if (player.is_ingame) {
+        func(player);
+      }
+    }
+  }
+
+private:
+  PlayerId next_player_id_ = 1;
+  std::unordered_map<PlayerId, Player> players_;
+  std::unordered_map<PlayerId, Net::ConnectionHandle> player_to_connection_;
+  std::unordered_map<Net::ConnectionHandle, PlayerId> connection_to_player_;
+};
+
+// Connection handles are RakNet GUIDs, so they are spread over the whole 64-bit range.
+std::vector<Net::ConnectionHandle> MakeConnections(std::size_t count) {
+  std::mt19937_64 rng(42);
+  std::vector<Net::ConnectionHandle> connections(count);
+  for (auto& connection : connections) {
+    connection = rng();
+  }
+  return connections;
+}
+
+// Fills a manager the way a server that has been running for a while looks: players joined and left in between.
+template <typename Manager>
+std::vector<Net::ConnectionHandle> Populate(Manager& manager, std::size_t count) {
+  const auto connections = MakeConnections(count * 2);
+  std::vector<PlayerId> ids;
+  for (auto connection : connections) {
+    ids.push_back(manager.AddPlayer(connection));
+  }
+  std::vector<Net::ConnectionHandle> remaining;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    if (i % 2 == 0) {
+      manager.RemovePlayer(ids[i]);
+    } else {
+      remaining.push_back(connections[i]);
+    }
+  }
+  return remaining;
+}
+
+// Adapts PlayerManager to the interface Populate and the benchmarks use.
+struct SlotMapPlayerManager {
+  PlayerManager manager;
+
+  PlayerId AddPlayer(Net::ConnectionHandle connection) {
+    return manager.AddPlayer(connection, std::string());
+  }
+
+  bool RemovePlayer(PlayerId player_id) {
+    return manager.RemovePlayer(player_id);
+  }
+
+  Player* GetPlayerByConnection(Net::ConnectionHandle connection) {
+    auto player = manager.GetPlayerByConnection(connection);
+    return player ? &player->get() : nullptr;
+  }
+
+  template <typename Func>
+  void ForEachIngamePlayer(Func&& func) {
+    manager.ForEachIngamePlayer(func);
+  }
+};
+
+template <typename Manager>
+void BM_GetPlayerByConnection(benchmark::State& state) {
+  Manager manager;
+  const auto connections = Populate(manager, static_cast<std::size_t>(state.range(0)));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(manager.GetPlayerByConnection(connections[i]));
+    i = i + 1 == connections.size() ? 0 : i + 1;
+  }
+}
+
+template <typename Manager>
+void BM_ForEachIngamePlayer(benchmark::State& state) {
+  Manager manager;
+  const auto connections = Populate(manager, static_cast<std::size_t>(state.range(0)));
+  for (auto connection : connections) {
+    manager.GetPlayerByConnection(connection)->is_ingame = 1;
+  }
+  for (auto _ : state) {
+    float sum = 0.0f;
+    manager.ForEachIngamePlayer([&](const Player& player) { sum += player.state.position.x; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The passes a tick makes over all players outside of snapshot building: the respawn check, recording
+// the lag compensation history and mirroring the positions for the distance kernel.
+void BM_TickPlayerPasses(benchmark::State& state) {
+  PlayerManager manager;
+  const auto player_count = static_cast<std::size_t>(state.range(0));
+  const auto connections = MakeConnections(player_count);
+  for (std::size_t i = 0; i < player_count; ++i) {
+    auto& player = manager.GetPlayer(manager.AddPlayer(connections[i], "Player" + std::to_string(i)))->get();
+    player.is_ingame = 1;
+    player.state.position = glm::vec3(static_cast<float>(i));
+  }
+
+  std::vector<PlayerState> history(player_count);
+  std::vector<float> positions(player_count * 3);
+  for (auto _ : state) {
+    std::size_t respawns = 0;
+    manager.ForEachPlayer([&](const Player& player) {
+      if (player.is_ingame && player.tod != 0) {
+        ++respawns;
+      }
+    });
+
+    std::size_t i = 0;
+    manager.ForEachIngamePlayer([&](const Player& player) { history[i++] = player.state; });
+
+    i = 0;
+    manager.ForEachIngamePlayer([&](const Player& player) {
+      positions[i++] = player.state.position.x;
+      positions[i++] = player.state.position.y;
+      positions[i++] = player.state.position.z;
+    });
+
+    benchmark::DoNotOptimize(respawns);
+    benchmark::DoNotOptimize(history.data());
+    benchmark::DoNotOptimize(positions.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_TickPlayerPasses)->Arg(100)->Arg(500)->Arg(5000);
+BENCHMARK(BM_GetPlayerByConnection<HashMapPlayerManager>)->Arg(100)->Arg(500);
+BENCHMARK(BM_GetPlayerByConnection<SlotMapPlayerManager>)->Arg(100)->Arg(500);
+BENCHMARK(BM_ForEachIngamePlayer<HashMapPlayerManager>)->Arg(100)->Arg(500);
+BENCHMARK(BM_ForEachIngamePlayer<SlotMapPlayerManager>)->Arg(100)->Arg(500);
+
+BENCHMARK_MAIN();
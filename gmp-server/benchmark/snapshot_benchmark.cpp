@@ -0,0 +1,102 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "packets.h"
+#include "player_manager.h"
+#include "send_buffer_pool.h"
+#include "snapshot_builder.h"
+#include "spatial_grid.h"
+#include "worker_pool.h"
+
+namespace {
+
+constexpr std::size_t kPlayers = 500;
+// Small enough that most players have dozens of others within the near band.
+constexpr float kWorldHalfExtent = 15000.0f;
+
+// Builds and serializes a tick of snapshots for kPlayers players on state.range(0) threads, like GameServer::SendSnapshots.
+void BM_SnapshotTick(benchmark::State& state) {
+  const auto thread_count = static_cast<std::size_t>(state.range(0));
+
+  PlayerManager player_manager;
+  SpatialGrid spatial_grid(5000.0f);
+  std::mt19937 rng(1337);
+  std::uniform_real_distribution<float> horizontal(-kWorldHalfExtent, kWorldHalfExtent);
+  for (std::size_t i = 0; i < kPlayers; ++i) {
+    auto player_id = player_manager.AddPlayer(static_cast<Net::ConnectionHandle>(i + 1), "Player" + std::to_string(i));
+    auto& player = player_manager.GetPlayer(player_id)->get();
+    player.is_ingame = 1;
+    player.health = 100;
+    player.state.position = glm::vec3(horizontal(rng), 0.0f, horizontal(rng));
+    spatial_grid.Update(player_id, player.state.position);
+  }
+
+  WorkerPool worker_pool(thread_count);
+  SnapshotBuilder builder(player_manager, spatial_grid);
+  builder.SetWorkerCount(worker_pool.GetThreadCount());
+  std::vector<SnapshotPacket> packets(worker_pool.GetThreadCount());
+  std::vector<std::uint64_t> bytes_per_worker(worker_pool.GetThreadCount());
+
+  for (auto _ : state) {
+    // Everyone moves, so no state is suppressed as unchanged.
+    player_manager.ForEachIngamePlayer([](PlayerManager::Player& player) {
+      player.state.animation++;
+      player.state_revision++;
+    });
+
+    builder.BeginTick();
+    const auto& recipients = builder.GetRecipients();
+    const std::size_t chunk_size = std::max<std::size_t>(1, recipients.size() / (worker_pool.GetThreadCount() * 4));
+    worker_pool.ParallelFor(recipients.size(), chunk_size, [&](std::size_t begin, std::size_t end, std::size_t worker_index) {
+      SnapshotPacket& packet = packets[worker_index];
+      packet.packet_type = Net::PT_SNAPSHOT;
+      for (std::size_t recipient_index = begin; recipient_index < end; ++recipient_index) {
+        builder.Build(recipient_index, packet, SnapshotBuilder::kNoByteBudget, worker_index);
+        auto [lease, written_size] = SendBufferPool::ForCurrentThread().Serialize(packet);
+        bytes_per_worker[worker_index] += written_size;
+      }
+    });
+  }
+
+  std::uint64_t bytes = 0;
+  for (std::uint64_t worker_bytes : bytes_per_worker) {
+    bytes += worker_bytes;
+  }
+  state.SetItemsProcessed(state.iterations() * kPlayers);
+  state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+
+BENCHMARK(BM_SnapshotTick)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+-- MIT License
+
+-- Copyright (c) 2025 Gothic Multiplayer Team.
+
+-- Permission is hereby granted, free of charge, to any person obtaining a copy
+-- of this software and associated documentation files (the "Software"), to deal
+-- in the Software without restriction, including without limitation the rights
+-- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+-- copies of the Software, and to permit persons to whom the Software is
+-- furnished to do so, subject to the following conditions:
+
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Software.
+
+-- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+-- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+-- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+-- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+-- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+-- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+-- SOFTWARE.
+
+target("InterestBenchmark")
+    set_kind("binary")
+    add_files("interest_benchmark.cpp")
+    add_deps("Server")
+    add_packages("benchmark")
+    set_rundir(os.projectdir())
+    -- disable the build by default
+    set_default(false)
+
+target("ConnectionLookupBenchmark")
+    set_kind("binary")
+    add_files("connection_lookup_benchmark.cpp")
+    add_deps("RakNet")
+    add_packages("benchmark")
+    -- disable the build by default
+    set_default(false)
+
+target("SnapshotBenchmark")
+    set_kind("binary")
+    add_files("snapshot_benchmark.cpp")
+    add_deps("Server")
+    add_packages("benchmark")
+    set_rundir(os.projectdir())
+    -- disable the build by default
+    set_default(false)
+
+target("PlayerManagerBenchmark")
+    set_kind("binary")
+    add_files("player_manager_benchmark.cpp")
+    add_deps("Server")
+    add_packages("benchmark")
+    -- disable the build by default
+    set_default(false)
+
+target("JoinBenchmark")
+    set_kind("binary")
+    add_files("join_benchmark.cpp")
+    add_deps("Server")
+    add_packages("benchmark")
+    -- disable the build by default
+    set_default(false)
+
+target("PacketCodecBenchmark")
+    set_kind("binary")
+    add_files("packet_codec_benchmark.cpp")
+    add_deps("Server")
+    add_packages("benchmark")
+    -- disable the build by default
+    set_default(false)
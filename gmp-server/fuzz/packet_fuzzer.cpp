@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "net_enums.h"
+#include "packet_registry.h"
+#include "packet_views.h"
+#include "packets.h"
+
+// Feeds arbitrary buffers through the packet header parsing and both dispatchers, with every registered packet id routed
+// to a handler that does nothing, so the decoders are what's being tested. On top of that, the message and join views
+// have to agree with the structs they stand in for.
+//
+// Built with the libfuzzer option this is a libFuzzer target, otherwise it runs the files given on the command line
+// (or stdin), which is what AFL expects from `PacketFuzzer @@`.
+
+namespace {
+
+using Net::PacketDirection;
+using Net::PacketID;
+
+struct NullHandler {
+  template <PacketDirection Direction, PacketID Id>
+  void On(typename Net::PacketDef<Direction, Id>::Type&) {
+  }
+};
+
+template <PacketDirection Direction, std::size_t Id>
+constexpr auto RouteIfRegistered() {
+  constexpr auto kId = static_cast<PacketID>(Id);
+  if constexpr (Net::RegisteredPacket<Direction, kId>) {
+    return std::tuple{Net::PacketRoute<kId, &NullHandler::On<Direction, kId>>{}};
+  } else {
+    return std::tuple{};
+  }
+}
+
+template <PacketDirection Direction, std::size_t... Ids>
+constexpr auto MakeDispatcher(std::index_sequence<Ids...>) {
+  return std::apply([](auto... routes) { return Net::PacketDispatcher<Direction, NullHandler>::Make(routes...); },
+                    std::tuple_cat(RouteIfRegistered<Direction, Ids>()...));
+}
+
+constexpr auto kServerDispatcher = MakeDispatcher<PacketDirection::kToServer>(std::make_index_sequence<256>{});
+constexpr auto kClientDispatcher = MakeDispatcher<PacketDirection::kToClient>(std::make_index_sequence<256>{});
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "Check failed: %s\n", what);
+    std::abort();
+  }
+}
+
+void CheckMessageView(unsigned char* data, std::uint32_t size) {
+  MessagePacket packet;
+  Net::MessagePacketView view;
+  const bool decoded = Net::DecodePacket<PacketDirection::kToServer, Net::PT_MSG>(data, size, packet);
+  Check(decoded == Net::DecodePacket<PacketDirection::kToServer, Net::PT_MSG>(data, size, view), "message view decodes the same bytes");
+  if (!decoded) {
+    return;
+  }
+  Check(view.packet_type == packet.packet_type && view.message == packet.message && view.sender == packet.sender &&
+            view.recipient == packet.recipient,
+        "message view matches the packet");
+
+  // What the server relays has to reach the client as the same message, now from the server-set sender.
+  constexpr NetId kSender = 0xBEEF;
+  std::vector<std::uint8_t> relayed;
+  const std::size_t relayed_size = Net::WriteMessageWithSender(view, kSender, relayed);
+  MessagePacket received;
+  Check(Net::DecodePacket<PacketDirection::kToClient, Net::PT_MSG>(relayed.data(), static_cast<std::uint32_t>(relayed_size), received),
+        "relayed message decodes");
+  Check(received.packet_type == packet.packet_type && received.message == packet.message && received.sender == kSender &&
+            received.recipient == packet.recipient,
+        "relayed message only changes the sender");
+}
+
+void CheckJoinGameView(unsigned char* data, std::uint32_t size) {
+  JoinGamePacket packet;
+  Net::JoinGamePacketView view;
+  const bool decoded = Net::DecodePacket<PacketDirection::kToServer, Net::PT_JOIN_GAME>(data, size, packet);
+  Check(decoded == Net::DecodePacket<PacketDirection::kToServer, Net::PT_JOIN_GAME>(data, size, view), "join view decodes the same bytes");
+  if (!decoded) {
+    return;
+  }
+  // Compared bitwise, the fuzzer is good at finding NaNs.
+  Check(std::memcmp(&view.position, &packet.position, sizeof(view.position)) == 0 &&
+            std::memcmp(&view.normal, &packet.normal, sizeof(view.normal)) == 0,
+        "join view transform matches the packet");
+  Check(view.packet_type == packet.packet_type && view.selected_class == packet.selected_class &&
+            view.left_hand_item_instance == packet.left_hand_item_instance &&
+            view.right_hand_item_instance == packet.right_hand_item_instance &&
+            view.equipped_armor_instance == packet.equipped_armor_instance && view.animation == packet.animation &&
+            view.head_model == packet.head_model && view.skin_texture == packet.skin_texture && view.face_texture == packet.face_texture &&
+            view.walk_style == packet.walk_style && view.player_name == packet.player_name && view.player_id == packet.player_id,
+        "join view matches the packet");
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* input, std::size_t input_size) {
+  if (input_size > UINT32_MAX) {
+    return 0;
+  }
+  // Exact-size copy, so reads past the end are caught by the sanitizers.
+  std::vector<unsigned char> buffer(input, input + input_size);
+  const auto size = static_cast<std::uint32_t>(input_size);
+  const auto header = Net::ReadPacketHeader(buffer.data(), size);
+  if (!header) {
+    return 0;
+  }
+  unsigned char* payload = buffer.data() + header->offset;
+  const std::uint32_t payload_size = size - header->offset;
+
+  NullHandler handler;
+  kServerDispatcher.Dispatch(handler, header->id, payload, payload_size);
+  kClientDispatcher.Dispatch(handler, header->id, payload, payload_size);
+  CheckMessageView(payload, payload_size);
+  CheckJoinGameView(payload, payload_size);
+  return 0;
+}
+
+#ifndef GMP_LIBFUZZER
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::vector<char> input{std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>()};
+    return LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+  }
+  for (int i = 1; i < argc; ++i) {
+    std::ifstream file(argv[i], std::ios::binary);
+    if (!file) {
+      std::fprintf(stderr, "Can't open %s\n", argv[i]);
+      return 1;
+    }
+    std::vector<char> input{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+  }
+  return 0;
+}
+#endif
@@ -0,0 +1,39 @@
+-- MIT License
+
+-- Copyright (c) 2025 Gothic Multiplayer Team.
+
+-- Permission is hereby granted, free of charge, to any person obtaining a copy
+-- of this software and associated documentation files (the "Software"), to deal
+-- in the Software without restriction, including without limitation the rights
+-- to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+-- copies of the Software, and to permit persons to whom the Software is
+-- furnished to do so, subject to the following conditions:
+
+-- The above copyright notice and this permission notice shall be included in all
+-- copies or substantial portions of the Software.
+
+-- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+-- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+-- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+-- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+-- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+-- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+-- SOFTWARE.
+
+option("libfuzzer")
+    set_showmenu(true)
+    set_description("Build the fuzz targets for libFuzzer, otherwise they run the input files given on the command line")
+    set_default(false)
+option_end()
+
+target("PacketFuzzer")
+    set_kind("binary")
+    add_files("packet_fuzzer.cpp")
+    add_deps("Server")
+    if has_config("libfuzzer") then
+        add_defines("GMP_LIBFUZZER")
+        add_cxflags("-fsanitize=fuzzer,address,undefined", {force = true})
+        add_ldflags("-fsanitize=fuzzer,address,undefined", {force = true})
+    end
+    -- disable the build by default
+    set_default(false)
@@ -105,7 +105,7 @@ void RegisterProxies() {
     OnPlayerHitEvent player_hit_event = std::any_cast<OnPlayerHitEvent>(args.event);
     sol::state_view lua(args.callback.lua_state());
     sol::object attacker = player_hit_event.attacker_id.has_value() ? sol::make_object(lua, player_hit_event.attacker_id.value()) : sol::lua_nil;
-    args.callback(attacker, player_hit_event.victim_id, player_hit_event.damage);
+    args.callback(attacker, player_hit_event.victim_id, player_hit_event.damage, player_hit_event.rejected);
   }};
 }
 
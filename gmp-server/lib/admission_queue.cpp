@@ -0,0 +1,70 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "admission_queue.h"
+
+#include <algorithm>
+
+void AdmissionQueue::Push(Net::ConnectionHandle connection, std::span<const unsigned char> data, Clock::time_point now) {
+  auto it = std::find_if(entries_.begin(), entries_.end(), [connection](const Entry& entry) { return entry.connection == connection; });
+  if (it != entries_.end()) {
+    it->data.assign(data.begin(), data.end());
+    return;
+  }
+
+  entries_.push_back(Entry{connection, std::vector<unsigned char>(data.begin(), data.end()), now});
+  stats_.queued.store(entries_.size(), std::memory_order_relaxed);
+}
+
+bool AdmissionQueue::Remove(Net::ConnectionHandle connection) {
+  auto it = std::find_if(entries_.begin(), entries_.end(), [connection](const Entry& entry) { return entry.connection == connection; });
+  if (it == entries_.end()) {
+    return false;
+  }
+  entries_.erase(it);
+  stats_.queued.store(entries_.size(), std::memory_order_relaxed);
+  return true;
+}
+
+std::optional<std::size_t> AdmissionQueue::GetPosition(Net::ConnectionHandle connection) const {
+  auto it = std::find_if(entries_.begin(), entries_.end(), [connection](const Entry& entry) { return entry.connection == connection; });
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return static_cast<std::size_t>(it - entries_.begin()) + 1;
+}
+
+void AdmissionQueue::Clear() {
+  entries_.clear();
+  stats_.queued.store(0, std::memory_order_relaxed);
+}
+
+void AdmissionQueue::RecordAdmission(const Entry& entry, Clock::time_point now) {
+  const auto wait_us = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - entry.enqueued).count());
+  stats_.admitted.fetch_add(1, std::memory_order_relaxed);
+  stats_.total_wait_us.fetch_add(wait_us, std::memory_order_relaxed);
+  if (wait_us > stats_.max_wait_us.load(std::memory_order_relaxed)) {
+    stats_.max_wait_us.store(wait_us, std::memory_order_relaxed);
+  }
+}
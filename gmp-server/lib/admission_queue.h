@@ -0,0 +1,150 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "znet_server.h"
+
+/**
+ * @brief First come, first served queue of connections waiting to be let further into the server
+ *
+ * The server keeps one for new connections and one for join requests and admits only a limited
+ * number from each per tick, so a crowd reconnecting at once after a restart is spread over many
+ * ticks instead of stalling one. Every entry can carry a copy of the packet that queued it.
+ */
+class AdmissionQueue {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    Net::ConnectionHandle connection;
+    std::vector<unsigned char> data;
+    Clock::time_point enqueued;
+    // 1-based position the connection was last told about, 0 if none yet.
+    std::size_t reported_position{0};
+  };
+
+  // Counters are atomics, so they can be read while the main loop runs on another thread.
+  struct Stats {
+    std::atomic<std::uint64_t> queued{0};
+    std::atomic<std::uint64_t> admitted{0};
+    std::atomic<std::uint64_t> total_wait_us{0};
+    std::atomic<std::uint64_t> max_wait_us{0};
+  };
+
+  // Which entries ReportPositions calls back for.
+  enum class ReportMode {
+    // Entries that were never told their position.
+    kNewEntries,
+    // Entries whose position changed since they were last told.
+    kChangedPositions,
+  };
+
+  /**
+   * @brief Queues a connection, or updates the data of its queued entry keeping its place
+   */
+  void Push(Net::ConnectionHandle connection, std::span<const unsigned char> data, Clock::time_point now);
+
+  /**
+   * @brief Drops the entry of a connection that went away
+   * @return Whether the connection was queued
+   */
+  bool Remove(Net::ConnectionHandle connection);
+
+  /**
+   * @brief Takes up to `limit` of the oldest entries off the queue and passes them to `admit`
+   * @param limit 0 admits everyone
+   * @return Number of admitted entries
+   */
+  template <typename Func>
+  std::size_t Admit(std::size_t limit, Clock::time_point now, Func&& admit) {
+    const std::size_t count = limit == 0 ? entries_.size() : std::min(limit, entries_.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      // Moved out first, admit may push to this queue again.
+      Entry entry = std::move(entries_.front());
+      entries_.pop_front();
+      RecordAdmission(entry, now);
+      admit(entry);
+    }
+    stats_.queued.store(entries_.size(), std::memory_order_relaxed);
+    return count;
+  }
+
+  /**
+   * @brief Calls `report(connection, position, size)` for queued entries, see ReportMode
+   */
+  template <typename Func>
+  void ReportPositions(ReportMode mode, Func&& report) {
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+      Entry& entry = entries_[i];
+      const std::size_t position = i + 1;
+      if (mode == ReportMode::kNewEntries ? entry.reported_position == 0 : entry.reported_position != position) {
+        entry.reported_position = position;
+        report(entry.connection, position, entries_.size());
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the 1-based position of a connection
+   */
+  std::optional<std::size_t> GetPosition(Net::ConnectionHandle connection) const;
+
+  std::size_t GetSize() const {
+    return entries_.size();
+  }
+
+  /**
+   * @brief How long the entry at the front has been waiting
+   */
+  Clock::duration GetOldestWait(Clock::time_point now) const {
+    return entries_.empty() ? Clock::duration::zero() : now - entries_.front().enqueued;
+  }
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+  void ResetMaxWait() {
+    stats_.max_wait_us.store(0, std::memory_order_relaxed);
+  }
+
+  void Clear();
+
+private:
+  void RecordAdmission(const Entry& entry, Clock::time_point now);
+
+  std::deque<Entry> entries_;
+  Stats stats_;
+};
@@ -32,6 +32,7 @@ SOFTWARE.
 #include <spdlog/fmt/ranges.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <fstream>
@@ -41,11 +42,13 @@ SOFTWARE.
 #include <string_view>
 #include <vector>
 
+#include "common_structs.h"
 #include "shared/toml_wrapper.h"
 
 namespace {
 constexpr std::uint32_t kMaxNameLength = 100;
 constexpr std::uint32_t kMaxAuthKeyLength = 32;
+constexpr std::int32_t kMaxWorkerThreads = 64;
 
 const std::unordered_map<std::string, std::variant<std::string, std::vector<std::string>, std::int32_t, bool>> kDefault_Config_Values = {
     {"name", std::string("Gothic Multiplayer Server")},
@@ -65,6 +68,22 @@ const std::unordered_map<std::string, std::variant<std::string, std::vector<std:
     {"log_level", std::string("trace")},
     {"scripts", std::vector<std::string>{std::string("main.lua")}},
     {"tick_rate_ms", 100},
+    {"net_poll_interval_ms", 2},
+    {"max_catch_up_ticks", 3},
+    {"worker_threads", 1},
+    {"delta_snapshots", true},
+    {"lod_full_radius", 1500},
+    {"lod_full_interval", 1},
+    {"lod_near_radius", 5000},
+    {"lod_near_interval", 2},
+    {"lod_far_interval", 10},
+    {"snapshot_keepalive_interval", 10},
+    {"snapshot_budget_bytes", 4096},
+    {"adaptive_snapshot_budget", true},
+    {"max_hit_distance", 6000},
+    {"lag_compensation_ms", 1000},
+    {"max_handshakes_per_tick", 20},
+    {"max_joins_per_tick", 10},
 #ifndef WIN32
     {"daemon", true}
 #else
@@ -156,6 +175,71 @@ void Config::ValidateAndFixValues() {
     SPDLOG_WARN("Invalid log level in config: {}. Setting to default \"{}\"", log_level, default_log_level);
     values_["log_level"] = default_log_level;
   }
+
+  auto& max_catch_up_ticks = std::get<std::int32_t>(values_.at("max_catch_up_ticks"));
+  if (max_catch_up_ticks < 0) {
+    SPDLOG_WARN("Invalid max_catch_up_ticks in config: {}. Setting to 0", max_catch_up_ticks);
+    max_catch_up_ticks = 0;
+  }
+
+  auto& snapshot_budget_bytes = std::get<std::int32_t>(values_.at("snapshot_budget_bytes"));
+  if (snapshot_budget_bytes < 0) {
+    SPDLOG_WARN("Invalid snapshot_budget_bytes in config: {}. Setting to 0 (unlimited)", snapshot_budget_bytes);
+    snapshot_budget_bytes = 0;
+  }
+
+  auto& max_hit_distance = std::get<std::int32_t>(values_.at("max_hit_distance"));
+  if (max_hit_distance < 0) {
+    SPDLOG_WARN("Invalid max_hit_distance in config: {}. Setting to 0 (no check)", max_hit_distance);
+    max_hit_distance = 0;
+  }
+
+  auto& lag_compensation_ms = std::get<std::int32_t>(values_.at("lag_compensation_ms"));
+  if (lag_compensation_ms < 0) {
+    SPDLOG_WARN("Invalid lag_compensation_ms in config: {}. Setting to 0", lag_compensation_ms);
+    lag_compensation_ms = 0;
+  }
+
+  for (const char* key : {"max_handshakes_per_tick", "max_joins_per_tick"}) {
+    auto& limit = std::get<std::int32_t>(values_.at(key));
+    if (limit < 0) {
+      SPDLOG_WARN("Invalid {} in config: {}. Setting to 0 (no limit)", key, limit);
+      limit = 0;
+    }
+  }
+
+  auto& worker_threads = std::get<std::int32_t>(values_.at("worker_threads"));
+  if (worker_threads < 0 || worker_threads > kMaxWorkerThreads) {
+    const auto clamped = std::clamp(worker_threads, 0, kMaxWorkerThreads);
+    SPDLOG_WARN("Invalid worker_threads in config: {}. Setting to {}", worker_threads, clamped);
+    worker_threads = clamped;
+  }
+
+  // Intervals and radii that must be positive.
+  for (const char* key : {"tick_rate_ms", "net_poll_interval_ms", "lod_full_radius", "lod_full_interval", "lod_near_radius", "lod_near_interval",
+                          "lod_far_interval", "snapshot_keepalive_interval"}) {
+    auto& value = std::get<std::int32_t>(values_.at(key));
+    if (value < 1) {
+      auto default_value = std::get<std::int32_t>(kDefault_Config_Values.at(key));
+      SPDLOG_WARN("Invalid {} in config: {}. Setting to default {}", key, value, default_value);
+      value = default_value;
+    }
+  }
+
+  // Clients only keep kSnapshotBaselineWindow snapshots, a later keepalive would refer to a baseline they dropped.
+  constexpr std::int32_t kMaxKeepaliveInterval = kSnapshotBaselineWindow - 1;
+  auto& snapshot_keepalive_interval = std::get<std::int32_t>(values_.at("snapshot_keepalive_interval"));
+  if (snapshot_keepalive_interval > kMaxKeepaliveInterval) {
+    SPDLOG_WARN("Invalid snapshot_keepalive_interval in config: {}. Setting to {}", snapshot_keepalive_interval, kMaxKeepaliveInterval);
+    snapshot_keepalive_interval = kMaxKeepaliveInterval;
+  }
+
+  auto& lod_full_radius = std::get<std::int32_t>(values_.at("lod_full_radius"));
+  const auto lod_near_radius = std::get<std::int32_t>(values_.at("lod_near_radius"));
+  if (lod_full_radius > lod_near_radius) {
+    SPDLOG_WARN("lod_full_radius ({}) is larger than lod_near_radius ({}), clamping it", lod_full_radius, lod_near_radius);
+    lod_full_radius = lod_near_radius;
+  }
 }
 
 void Config::LogConfigValues() const {
@@ -193,6 +277,25 @@ void Config::LogConfigValues() const {
   SPDLOG_INFO("");
   SPDLOG_INFO("-= Performance =-");
   SPDLOG_INFO("* {:<18}: {} ms", "Tick rate", Get<std::int32_t>("tick_rate_ms"));
+  SPDLOG_INFO("* {:<18}: {} ms", "Network poll", Get<std::int32_t>("net_poll_interval_ms"));
+  SPDLOG_INFO("* {:<18}: {}", "Max catch-up ticks", Get<std::int32_t>("max_catch_up_ticks"));
+  const auto worker_threads = Get<std::int32_t>("worker_threads");
+  SPDLOG_INFO("* {:<18}: {}", "Worker threads", worker_threads > 0 ? std::to_string(worker_threads) : std::string("auto"));
+  SPDLOG_INFO("* {:<18}: {}", "Delta snapshots", bool_to_string(Get<bool>("delta_snapshots")));
+  SPDLOG_INFO("* {:<18}: < {} every {} tick(s)", "LOD full", Get<std::int32_t>("lod_full_radius"), Get<std::int32_t>("lod_full_interval"));
+  SPDLOG_INFO("* {:<18}: < {} every {} tick(s)", "LOD near", Get<std::int32_t>("lod_near_radius"), Get<std::int32_t>("lod_near_interval"));
+  SPDLOG_INFO("* {:<18}: every {} tick(s)", "LOD far (map only)", Get<std::int32_t>("lod_far_interval"));
+  SPDLOG_INFO("* {:<18}: every {} tick(s)", "Idle keepalive", Get<std::int32_t>("snapshot_keepalive_interval"));
+  const auto snapshot_budget_bytes = Get<std::int32_t>("snapshot_budget_bytes");
+  SPDLOG_INFO("* {:<18}: {}, adaptive: {}", "Snapshot budget",
+              snapshot_budget_bytes > 0 ? fmt::format("{} bytes/tick", snapshot_budget_bytes) : std::string("unlimited"),
+              bool_to_string(Get<bool>("adaptive_snapshot_budget")));
+  const auto max_hit_distance = Get<std::int32_t>("max_hit_distance");
+  SPDLOG_INFO("* {:<18}: {}, rewind up to {} ms", "Max hit distance", max_hit_distance > 0 ? std::to_string(max_hit_distance) : std::string("off"),
+              Get<std::int32_t>("lag_compensation_ms"));
+  const auto admission_limit_to_string = [](std::int32_t limit) { return limit > 0 ? std::to_string(limit) : std::string("unlimited"); };
+  SPDLOG_INFO("* {:<18}: {} connections, {} joins per tick", "Admission", admission_limit_to_string(Get<std::int32_t>("max_handshakes_per_tick")),
+              admission_limit_to_string(Get<std::int32_t>("max_joins_per_tick")));
 
 #ifndef WIN32
   const bool daemon = Get<bool>("daemon");
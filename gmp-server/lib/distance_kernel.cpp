@@ -0,0 +1,199 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "distance_kernel.h"
+
+#include <cassert>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GMP_DISTANCE_KERNEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts AVX2 intrinsics anywhere, GCC and Clang only in functions compiled for AVX2.
+#if defined(GMP_DISTANCE_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GMP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GMP_TARGET_AVX2
+#endif
+
+namespace {
+
+std::uint8_t GetBand(float distance_squared, std::span<const float> band_limits_squared) {
+  std::uint8_t band = 0;
+  for (float limit : band_limits_squared) {
+    band += distance_squared >= limit ? 1 : 0;
+  }
+  return band;
+}
+
+void ClassifyScalar(const PositionArrays& positions, std::span<const std::uint32_t> indices, const glm::vec3& origin,
+                    std::span<const float> band_limits_squared, std::uint8_t* bands, float* distances_squared, std::size_t first) {
+  for (std::size_t i = first; i < indices.size(); ++i) {
+    const std::uint32_t index = indices[i];
+    const float dx = positions.x[index] - origin.x;
+    const float dy = positions.y[index] - origin.y;
+    const float dz = positions.z[index] - origin.z;
+    float distance_squared = dx * dx;
+    distance_squared += dy * dy;
+    distance_squared += dz * dz;
+    distances_squared[i] = distance_squared;
+    bands[i] = GetBand(distance_squared, band_limits_squared);
+  }
+}
+
+#ifdef GMP_DISTANCE_KERNEL_X86
+
+// SSE2 has no gather, so lanes are loaded one by one. The arithmetic is what gets vectorized.
+void ClassifySse2(const PositionArrays& positions, std::span<const std::uint32_t> indices, const glm::vec3& origin,
+                  std::span<const float> band_limits_squared, std::uint8_t* bands, float* distances_squared) {
+  const __m128 origin_x = _mm_set1_ps(origin.x);
+  const __m128 origin_y = _mm_set1_ps(origin.y);
+  const __m128 origin_z = _mm_set1_ps(origin.z);
+  const float* x = positions.x.data();
+  const float* y = positions.y.data();
+  const float* z = positions.z.data();
+
+  std::size_t i = 0;
+  for (; i + 4 <= indices.size(); i += 4) {
+    const std::uint32_t* lane = indices.data() + i;
+    const __m128 dx = _mm_sub_ps(_mm_set_ps(x[lane[3]], x[lane[2]], x[lane[1]], x[lane[0]]), origin_x);
+    const __m128 dy = _mm_sub_ps(_mm_set_ps(y[lane[3]], y[lane[2]], y[lane[1]], y[lane[0]]), origin_y);
+    const __m128 dz = _mm_sub_ps(_mm_set_ps(z[lane[3]], z[lane[2]], z[lane[1]], z[lane[0]]), origin_z);
+    const __m128 distance_squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+    _mm_storeu_ps(distances_squared + i, distance_squared);
+
+    // Every limit the distance reaches adds 1, comparisons yield -1 per matching lane.
+    __m128i band = _mm_setzero_si128();
+    for (float limit : band_limits_squared) {
+      band = _mm_sub_epi32(band, _mm_castps_si128(_mm_cmpge_ps(distance_squared, _mm_set1_ps(limit))));
+    }
+    alignas(16) std::int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), band);
+    for (std::size_t j = 0; j < 4; ++j) {
+      bands[i + j] = static_cast<std::uint8_t>(lanes[j]);
+    }
+  }
+  ClassifyScalar(positions, indices, origin, band_limits_squared, bands, distances_squared, i);
+}
+
+GMP_TARGET_AVX2 void ClassifyAvx2(const PositionArrays& positions, std::span<const std::uint32_t> indices, const glm::vec3& origin,
+                                  std::span<const float> band_limits_squared, std::uint8_t* bands, float* distances_squared) {
+  const __m256 origin_x = _mm256_set1_ps(origin.x);
+  const __m256 origin_y = _mm256_set1_ps(origin.y);
+  const __m256 origin_z = _mm256_set1_ps(origin.z);
+
+  std::size_t i = 0;
+  for (; i + 8 <= indices.size(); i += 8) {
+    const __m256i lane = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices.data() + i));
+    const __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(positions.x.data(), lane, 4), origin_x);
+    const __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(positions.y.data(), lane, 4), origin_y);
+    const __m256 dz = _mm256_sub_ps(_mm256_i32gather_ps(positions.z.data(), lane, 4), origin_z);
+    const __m256 distance_squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+    _mm256_storeu_ps(distances_squared + i, distance_squared);
+
+    __m256i band = _mm256_setzero_si256();
+    for (float limit : band_limits_squared) {
+      band = _mm256_sub_epi32(band, _mm256_castps_si256(_mm256_cmp_ps(distance_squared, _mm256_set1_ps(limit), _CMP_GE_OQ)));
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), band);
+    for (std::size_t j = 0; j < 8; ++j) {
+      bands[i + j] = static_cast<std::uint8_t>(lanes[j]);
+    }
+  }
+  ClassifyScalar(positions, indices, origin, band_limits_squared, bands, distances_squared, i);
+}
+
+bool CpuSupportsAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+  // AVX2 also needs the OS to save the YMM registers.
+  __cpuid(info, 1);
+  const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+  __cpuidex(info, 7, 0);
+  return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+  return false;
+#endif
+}
+
+#endif  // GMP_DISTANCE_KERNEL_X86
+
+}  // namespace
+
+bool IsDistanceKernelSupported(DistanceKernel kernel) {
+  switch (kernel) {
+    case DistanceKernel::kScalar:
+      return true;
+#ifdef GMP_DISTANCE_KERNEL_X86
+    case DistanceKernel::kSse2:
+      return true;
+    case DistanceKernel::kAvx2:
+      return CpuSupportsAvx2();
+#else
+    case DistanceKernel::kSse2:
+    case DistanceKernel::kAvx2:
+      return false;
+#endif
+  }
+  return false;
+}
+
+DistanceKernel GetBestDistanceKernel() {
+  static const DistanceKernel kBestKernel = IsDistanceKernelSupported(DistanceKernel::kAvx2)   ? DistanceKernel::kAvx2
+                                            : IsDistanceKernelSupported(DistanceKernel::kSse2) ? DistanceKernel::kSse2
+                                                                                               : DistanceKernel::kScalar;
+  return kBestKernel;
+}
+
+void ClassifyDistances(const PositionArrays& positions, std::span<const std::uint32_t> indices, const glm::vec3& origin,
+                       std::span<const float> band_limits_squared, std::span<std::uint8_t> bands, std::span<float> distances_squared,
+                       DistanceKernel kernel) {
+  assert(band_limits_squared.size() <= kMaxDistanceBands);
+  assert(bands.size() >= indices.size() && distances_squared.size() >= indices.size());
+
+  switch (kernel) {
+#ifdef GMP_DISTANCE_KERNEL_X86
+    case DistanceKernel::kAvx2:
+      ClassifyAvx2(positions, indices, origin, band_limits_squared, bands.data(), distances_squared.data());
+      return;
+    case DistanceKernel::kSse2:
+      ClassifySse2(positions, indices, origin, band_limits_squared, bands.data(), distances_squared.data());
+      return;
+#endif
+    default:
+      ClassifyScalar(positions, indices, origin, band_limits_squared, bands.data(), distances_squared.data(), 0);
+      return;
+  }
+}
@@ -0,0 +1,92 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Player positions stored as separate coordinate arrays, so distances can be computed several at a time.
+ */
+struct PositionArrays {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<std::uint32_t> id;
+
+  void Clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    id.clear();
+  }
+
+  void Push(std::uint32_t player_id, const glm::vec3& position) {
+    x.push_back(position.x);
+    y.push_back(position.y);
+    z.push_back(position.z);
+    id.push_back(player_id);
+  }
+
+  std::size_t Size() const {
+    return id.size();
+  }
+};
+
+enum class DistanceKernel { kScalar, kSse2, kAvx2 };
+
+// Most band limits a single ClassifyDistances call accepts.
+constexpr std::size_t kMaxDistanceBands = 4;
+
+/**
+ * @brief Gets the fastest kernel the CPU supports, detected once at runtime
+ */
+DistanceKernel GetBestDistanceKernel();
+
+/**
+ * @brief Checks whether the CPU can run a kernel
+ */
+bool IsDistanceKernelSupported(DistanceKernel kernel);
+
+/**
+ * @brief Computes squared distances from origin to a batch of positions and sorts them into bands
+ *
+ * All kernels compute (dx * dx + dy * dy) + dz * dz in single precision without fused multiply-add,
+ * so they produce identical results.
+ *
+ * @param positions Positions to index into
+ * @param indices Batch of indices into positions
+ * @param origin Position the distances are measured from
+ * @param band_limits_squared Ascending squared radii, at most kMaxDistanceBands
+ * @param bands Receives for each index how many limits the squared distance is not below, so 0 is the innermost band
+ * @param distances_squared Receives the squared distances
+ * @param kernel Implementation to use, must be supported by the CPU
+ */
+void ClassifyDistances(const PositionArrays& positions, std::span<const std::uint32_t> indices, const glm::vec3& origin,
+                       std::span<const float> band_limits_squared, std::span<std::uint8_t> bands, std::span<float> distances_squared,
+                       DistanceKernel kernel = GetBestDistanceKernel());
@@ -32,11 +32,15 @@ SOFTWARE.
 #include <spdlog/spdlog.h>
 #include <version.h>
 
+#include <algorithm>
+#include <array>
 #include <charconv>
 #include <chrono>
+#include <cstring>
 #include <dylib.hpp>
 #include <future>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -48,8 +52,10 @@ SOFTWARE.
 #include "HTTPServer.h"
 #include "gothic_clock.h"
 #include "net_enums.h"
+#include "packet_registry.h"
 #include "packets.h"
 #include "platform_depend.h"
+#include "send_buffer_pool.h"
 #include "server_events.h"
 #include "shared/event.h"
 #include "shared/math.h"
@@ -201,12 +207,49 @@ void LogServerBanner() {
   SPDLOG_INFO("-= GMP Team 2011-2025");
 }
 
-template <typename Packet, typename TContainer = std::vector<std::uint8_t>>
+template <typename Packet>
 void SerializeAndSend(const Packet& packet, Net::PacketPriority priority, Net::PacketReliability reliable, Net::ConnectionHandle id,
                       std::uint32_t channel = 0) {
-  TContainer buffer;
-  auto written_size = bitsery::quickSerialization<bitsery::OutputBufferAdapter<TContainer>>(buffer, packet);
-  g_net_server->Send(buffer.data(), written_size, priority, reliable, channel, id);
+  auto [lease, written_size] = SendBufferPool::ForCurrentThread().Serialize(packet);
+  g_net_server->Send(lease.Get().data(), written_size, priority, reliable, channel, id);
+}
+
+// Serializes the packet once and sends the same bytes to all recipients.
+template <typename Packet>
+void SerializeAndBroadcast(const Packet& packet, Net::PacketPriority priority, Net::PacketReliability reliable,
+                           std::span<const Net::ConnectionHandle> recipients, std::uint32_t channel = 0) {
+  if (recipients.empty()) {
+    return;
+  }
+  auto [lease, written_size] = SendBufferPool::ForCurrentThread().Serialize(packet);
+  g_net_server->Broadcast(lease.Get().data(), written_size, priority, reliable, channel, recipients);
+}
+
+// Sends with the delivery registered for the packet id, see packet_registry.h.
+template <Net::PacketID Id>
+void SerializeAndSend(const typename Net::PacketDef<Net::PacketDirection::kToClient, Id>::Type& packet, Net::ConnectionHandle id) {
+  constexpr auto kTraits = Net::PacketDef<Net::PacketDirection::kToClient, Id>::kTraits;
+  SerializeAndSend(packet, kTraits.priority, kTraits.reliability, id, kTraits.channel);
+}
+
+template <Net::PacketID Id>
+void SerializeAndBroadcast(const typename Net::PacketDef<Net::PacketDirection::kToClient, Id>::Type& packet,
+                           std::span<const Net::ConnectionHandle> recipients) {
+  constexpr auto kTraits = Net::PacketDef<Net::PacketDirection::kToClient, Id>::kTraits;
+  SerializeAndBroadcast(packet, kTraits.priority, kTraits.reliability, recipients, kTraits.channel);
+}
+
+// Sends a received message on with `sender` filled in, without decoding and serializing the text again.
+template <Net::PacketID Id>
+void RelayMessage(const Net::MessagePacketView& packet, NetId sender, std::span<const Net::ConnectionHandle> recipients) {
+  if (recipients.empty()) {
+    return;
+  }
+  constexpr auto kTraits = Net::PacketDef<Net::PacketDirection::kToClient, Id>::kTraits;
+  auto lease = SendBufferPool::ForCurrentThread().Acquire(packet.size + sizeof(NetId) + 1);
+  const auto size = Net::WriteMessageWithSender(packet, sender, lease.Get());
+  g_net_server->Broadcast(lease.Get().data(), static_cast<std::uint32_t>(size), kTraits.priority, kTraits.reliability, kTraits.channel,
+                          recipients);
 }
 
 DiscordActivityPacket MakeDiscordActivityPacket(const GameServer::DiscordActivityState& activity) {
@@ -306,7 +349,28 @@ bool GameServer::Init() {
   }
 #endif
   auto slots = config_.Get<std::int32_t>("slots");
+  // Players never move in memory while joining, only when someone leaves.
+  player_manager_.Reserve(static_cast<std::size_t>(std::max(slots, 0)));
   allow_modification = config_.Get<bool>("allow_modification");
+  snapshot_builder_.SetDeltaCompression(config_.Get<bool>("delta_snapshots"));
+  snapshot_builder_.SetKeepaliveInterval(static_cast<std::uint32_t>(config_.Get<std::int32_t>("snapshot_keepalive_interval")));
+  const auto snapshot_budget_bytes = config_.Get<std::int32_t>("snapshot_budget_bytes");
+  snapshot_byte_budget_ = snapshot_budget_bytes > 0 ? static_cast<std::size_t>(snapshot_budget_bytes) : SnapshotBuilder::kNoByteBudget;
+  adaptive_snapshot_budget_ = config_.Get<bool>("adaptive_snapshot_budget");
+
+  SnapshotBuilder::LodSettings lod;
+  lod.full_radius = static_cast<float>(config_.Get<std::int32_t>("lod_full_radius"));
+  lod.full_interval = static_cast<std::uint32_t>(config_.Get<std::int32_t>("lod_full_interval"));
+  lod.near_radius = static_cast<float>(config_.Get<std::int32_t>("lod_near_radius"));
+  lod.near_interval = static_cast<std::uint32_t>(config_.Get<std::int32_t>("lod_near_interval"));
+  lod.far_interval = static_cast<std::uint32_t>(config_.Get<std::int32_t>("lod_far_interval"));
+  snapshot_builder_.SetLodSettings(lod);
+  // The neighbour query only looks one cell around the player, so cells must cover the whole near band.
+  spatial_grid_ = SpatialGrid(lod.near_radius);
+  max_hit_distance_ = static_cast<float>(config_.Get<std::int32_t>("max_hit_distance"));
+  lag_compensation_window_ = std::chrono::milliseconds(config_.Get<std::int32_t>("lag_compensation_ms"));
+  max_handshakes_per_tick_ = static_cast<std::size_t>(config_.Get<std::int32_t>("max_handshakes_per_tick"));
+  max_joins_per_tick_ = static_cast<std::size_t>(config_.Get<std::int32_t>("max_joins_per_tick"));
 
   auto port = config_.Get<std::int32_t>("port");
 
@@ -334,15 +398,24 @@ bool GameServer::Init() {
 
   SPDLOG_INFO(kFrame);
   script = std::make_unique<Script>(config_.Get<std::vector<std::string>>("scripts"));
-  last_update_time_ = std::chrono::steady_clock::now();
+  snapshot_stats_.since = std::chrono::steady_clock::now();
+  start_time_ = snapshot_stats_.since;
+
+  TickScheduler::Settings scheduler_settings;
+  scheduler_settings.tick_interval = std::chrono::milliseconds(config_.Get<std::int32_t>("tick_rate_ms"));
+  scheduler_settings.poll_interval = std::chrono::milliseconds(config_.Get<std::int32_t>("net_poll_interval_ms"));
+  scheduler_settings.max_catch_up_ticks = static_cast<std::uint32_t>(config_.Get<std::int32_t>("max_catch_up_ticks"));
+  scheduler_ = std::make_unique<TickScheduler>(scheduler_settings);
+  // One state per tick, plus one on each side of the window to interpolate against.
+  state_history_.SetSamplesPerPlayer(static_cast<std::size_t>(lag_compensation_window_ / scheduler_settings.tick_interval) + 2);
+
+  worker_pool_ = std::make_unique<WorkerPool>(static_cast<std::size_t>(config_.Get<std::int32_t>("worker_threads")));
+  snapshot_builder_.SetWorkerCount(worker_pool_->GetThreadCount());
+  snapshot_packets_.resize(worker_pool_->GetThreadCount());
+  SPDLOG_INFO("Building snapshots on {} thread(s)", worker_pool_->GetThreadCount());
 
   main_thread_running.store(true, std::memory_order_release);
-  main_thread = std::thread([this]() {
-    while (main_thread_running.load(std::memory_order_acquire)) {
-      Run();
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-  });
+  main_thread = std::thread([this]() { scheduler_->Run(main_thread_running, [this]() { Receive(); }, [this]() { Tick(); }); });
   SPDLOG_INFO("");
   SPDLOG_INFO(kFrame);
   SPDLOG_INFO("Gothic Multiplayer Server initialized successfully!");
@@ -350,99 +423,171 @@ bool GameServer::Init() {
   return true;
 }
 
-void GameServer::Run() {
-  constexpr double kRadius = 5000.0;
-
-  g_net_server->Pulse();
+void GameServer::Tick() {
+  ++server_tick_;
   clock_->RunClock();
 
   if (script) {
     script->ProcessTimers();
   }
 
+  ProcessAdmissions();
   ProcessRespawns();
+  RecordStateHistory();
+  SendSnapshots();
+  LogServerStats();
+}
 
-  // Send updates to all players.
-  auto now = std::chrono::steady_clock::now();
-  if (now - last_update_time_ > std::chrono::milliseconds(config_.Get<std::int32_t>("tick_rate_ms"))) {
-    last_update_time_ = now;
-
-    // Pre-filter active players
-    std::vector<std::pair<PlayerId, const Player*>> active_players;
-    active_players.reserve(player_manager_.GetPlayerCount());
-    player_manager_.ForEachPlayer([&](const Player& player) {
-      if (player.is_ingame) {
-        active_players.emplace_back(player.player_id, &player);
-      }
-    });
+void GameServer::ProcessAdmissions() {
+  const auto now = AdmissionQueue::Clock::now();
+  handshake_queue_.Admit(max_handshakes_per_tick_, now, [this](AdmissionQueue::Entry& entry) { AdmitConnection(entry.connection); });
+  join_queue_.Admit(max_joins_per_tick_, now, [this](AdmissionQueue::Entry& entry) {
+    // Validated by HandleJoinRequest before it was queued. Decoded into an owning packet here, as the name is stored.
+    JoinGamePacket packet;
+    if (DecodePacket<PacketDirection::kToServer, PT_JOIN_GAME>(entry.data.data(), static_cast<std::uint32_t>(entry.data.size()), packet)) {
+      SomeoneJoinGame(entry.connection, packet);
+    }
+  });
 
-    using PlayersKey = std::pair<PlayerId, PlayerId>;
-    struct PlayersKeyHash {
-      std::size_t operator()(const PlayersKey& key) const {
-        std::hash<uint64_t> hasher;
-        return hasher(key.first) ^ (hasher(key.second) << 1);
-      }
-    };
+  auto mode = AdmissionQueue::ReportMode::kNewEntries;
+  if (now - last_queue_position_report_ >= kQueuePositionInterval) {
+    mode = AdmissionQueue::ReportMode::kChangedPositions;
+    last_queue_position_report_ = now;
+  }
+  auto send_position = [this](Net::ConnectionHandle connection, std::size_t position, std::size_t queue_size) {
+    SendQueuePosition(connection, position, queue_size);
+  };
+  handshake_queue_.ReportPositions(mode, send_position);
+  join_queue_.ReportPositions(mode, send_position);
+}
 
-    struct PlayersKeyEqual {
-      bool operator()(const PlayersKey& lhs, const PlayersKey& rhs) const {
-        return lhs.first == rhs.first && lhs.second == rhs.second;
-      }
-    };
+void GameServer::AdmitConnection(Net::ConnectionHandle connection) {
+  // Add player to the manager
+  PlayerId new_player_id = player_manager_.AddPlayer(connection, "");
+
+  // Send packet with initial information.
+  InitialInfoPacket packet;
+  packet.packet_type = PT_INITIAL_INFO;
+  packet.map_name = config_.Get<std::string>("map");
+  packet.player_id = player_manager_.GetPlayer(new_player_id)->get().net_id;
+  SerializeAndSend<PT_INITIAL_INFO>(packet, connection);
+  SPDLOG_INFO("Admitted connection {} from {}. Now we have {} connected users.", connection, g_net_server->GetPlayerIp(connection),
+              player_manager_.GetPlayerCount());
+}
+
+void GameServer::SendQueuePosition(Net::ConnectionHandle connection, std::size_t position, std::size_t queue_size) {
+  QueuePositionPacket packet;
+  packet.packet_type = PT_QUEUE_POSITION;
+  constexpr std::size_t kMaxReported = std::numeric_limits<std::uint16_t>::max();
+  packet.position = static_cast<std::uint16_t>(std::min(position, kMaxReported));
+  packet.queue_size = static_cast<std::uint16_t>(std::min(queue_size, kMaxReported));
+  SerializeAndSend<PT_QUEUE_POSITION>(packet, connection);
+}
 
-    // Pre-allocate map with estimated size
-    std::unordered_map<PlayersKey, float, PlayersKeyHash, PlayersKeyEqual> distances;
-    distances.reserve((active_players.size() * (active_players.size() - 1)) / 2);
-    // Iteration over player pairs
-    for (size_t i = 0; i < active_players.size(); ++i) {
-      for (size_t j = i + 1; j < active_players.size(); ++j) {
-        PlayersKey key{std::min(active_players[i].first, active_players[j].first), std::max(active_players[i].first, active_players[j].first)};
+void GameServer::RecordStateHistory() {
+  const auto now = StateHistory::Clock::now();
+  player_manager_.ForEachIngamePlayer([&](const Player& player) { state_history_.Record(player.player_id, now, player.state); });
+}
 
-        distances[key] = glm::distance(active_players[i].second->state.position, active_players[j].second->state.position);
-      }
-    }
+bool GameServer::IsHitInRange(const Player& attacker, const Player& victim) const {
+  if (max_hit_distance_ <= 0.0f) {
+    return true;
+  }
 
-    for (const auto& [players, distance] : distances) {
-      auto player_a_opt = player_manager_.GetPlayer(players.first);
-      auto player_b_opt = player_manager_.GetPlayer(players.second);
+  const int ping = g_net_server->GetAveragePing(attacker.connection);
+  const auto view_time = StateHistory::GetViewTime(StateHistory::Clock::now(), std::chrono::milliseconds(ping),
+                                                   scheduler_->GetSettings().tick_interval, lag_compensation_window_);
+  return state_history_.IsHitInRange(attacker.state, victim.player_id, victim.state, view_time, max_hit_distance_);
+}
 
-      if (!player_a_opt.has_value() || !player_b_opt.has_value()) {
+void GameServer::SendSnapshots() {
+  snapshot_builder_.BeginTick();
+  const auto& recipients = snapshot_builder_.GetRecipients();
+  // Wraps after 49 days, clients only compare nearby timestamps.
+  const auto server_time_ms =
+      static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time_).count());
+
+  // Recipients are independent, so each worker builds and serializes its share and sends it itself. NetServer allows concurrent
+  // sends as long as Pulse does not run, which it doesn't during a tick.
+  const std::size_t chunk_size = std::max<std::size_t>(1, recipients.size() / (worker_pool_->GetThreadCount() * kSnapshotChunksPerWorker));
+  worker_pool_->ParallelFor(recipients.size(), chunk_size, [&](std::size_t begin, std::size_t end, std::size_t worker_index) {
+    SnapshotPacket& packet = snapshot_packets_[worker_index];
+    packet.packet_type = PT_SNAPSHOT;
+    packet.server_tick = server_tick_;
+    packet.server_time_ms = server_time_ms;
+    for (std::size_t recipient_index = begin; recipient_index < end; ++recipient_index) {
+      const Net::ConnectionHandle connection = recipients[recipient_index]->connection;
+      snapshot_builder_.Build(recipient_index, packet, GetSnapshotByteBudget(connection), worker_index);
+      if (packet.player_states.empty() && packet.player_positions.empty()) {
         continue;
       }
+      SerializeAndSend<PT_SNAPSHOT>(packet, connection);
+    }
+  });
 
-      const auto& player_a = player_a_opt->get();
-      const auto& player_b = player_b_opt->get();
-
-      if (distance < kRadius) {
-        PlayerStateUpdatePacket player_a_update_packet;
-        player_a_update_packet.packet_type = PT_ACTUAL_STATISTICS;
-        player_a_update_packet.player_id = player_a.player_id;
-        player_a_update_packet.state = player_a.state;
-        player_a_update_packet.state.health_points = player_a.health;
-
-        PlayerStateUpdatePacket player_b_update_packet;
-        player_b_update_packet.packet_type = PT_ACTUAL_STATISTICS;
-        player_b_update_packet.player_id = player_b.player_id;
-        player_b_update_packet.state = player_b.state;
-        player_b_update_packet.state.health_points = player_b.health;
-
-        SerializeAndSend(player_a_update_packet, IMMEDIATE_PRIORITY, UNRELIABLE, player_b.connection);
-        SerializeAndSend(player_b_update_packet, IMMEDIATE_PRIORITY, UNRELIABLE, player_a.connection);
-      } else {
-        PlayerPositionUpdatePacket player_a_update_packet;
-        player_a_update_packet.packet_type = PT_MAP_ONLY;
-        player_a_update_packet.player_id = player_a.player_id;
-        player_a_update_packet.position = player_a.state.position;
-
-        PlayerPositionUpdatePacket player_b_update_packet;
-        player_b_update_packet.packet_type = PT_MAP_ONLY;
-        player_b_update_packet.player_id = player_b.player_id;
-        player_b_update_packet.position = player_b.state.position;
-
-        SerializeAndSend(player_a_update_packet, IMMEDIATE_PRIORITY, UNRELIABLE, player_b.connection);
-        SerializeAndSend(player_b_update_packet, IMMEDIATE_PRIORITY, UNRELIABLE, player_a.connection);
-      }
+  const auto& tick_stats = snapshot_builder_.GetTickStats();
+  snapshot_stats_.ticks++;
+  snapshot_stats_.sent_states += tick_stats.sent_states;
+  snapshot_stats_.suppressed_states += tick_stats.suppressed_states;
+  snapshot_stats_.deferred_entries += tick_stats.deferred_entries;
+}
+
+std::size_t GameServer::GetSnapshotByteBudget(Net::ConnectionHandle connection) {
+  std::size_t budget = snapshot_byte_budget_;
+  Net::ConnectionStats stats;
+  if (!adaptive_snapshot_budget_ || !g_net_server->GetConnectionStats(connection, stats)) {
+    return budget;
+  }
+
+  if (stats.congestion_limited) {
+    const auto tick_ms = static_cast<std::uint64_t>(scheduler_->GetSettings().tick_interval.count());
+    budget = std::min<std::size_t>(budget, stats.congestion_limit_bytes_per_second * tick_ms / 1000);
+  }
+  // Whatever is still queued goes out before this snapshot, adding more on top would only delay it further.
+  budget -= std::min<std::size_t>(budget, stats.bytes_queued);
+  return std::max(budget, kMinSnapshotByteBudget);
+}
+
+std::span<const Net::ConnectionHandle> GameServer::GetIngameConnections(std::optional<PlayerId> excluded) {
+  broadcast_recipients_.clear();
+  player_manager_.ForEachIngamePlayer([&](const Player& player) {
+    if (player.player_id != excluded) {
+      broadcast_recipients_.push_back(player.connection);
+    }
+  });
+  return broadcast_recipients_;
+}
+
+void GameServer::LogServerStats() {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - snapshot_stats_.since < kSnapshotStatsInterval) {
+    return;
+  }
+
+  const double ticks = static_cast<double>(std::max<std::uint64_t>(snapshot_stats_.ticks, 1));
+  SPDLOG_DEBUG("Snapshot states per tick: {:.1f} sent, {:.1f} suppressed as unchanged, {:.1f} entries deferred by the byte budget",
+               snapshot_stats_.sent_states / ticks, snapshot_stats_.suppressed_states / ticks, snapshot_stats_.deferred_entries / ticks);
+  snapshot_stats_ = SnapshotStats{now};
+
+  const auto& scheduler_stats = scheduler_->GetStats();
+  const auto total_ticks = std::max<std::uint64_t>(scheduler_stats.ticks.load(std::memory_order_relaxed), 1);
+  SPDLOG_DEBUG("Tick budget: avg {:.2f} ms, max {:.2f} ms of {} ms, {} overruns and {} skipped ticks since start",
+               scheduler_stats.total_tick_us.load(std::memory_order_relaxed) / 1000.0 / total_ticks,
+               scheduler_stats.max_tick_us.load(std::memory_order_relaxed) / 1000.0, scheduler_->GetSettings().tick_interval.count(),
+               scheduler_stats.overruns.load(std::memory_order_relaxed), scheduler_stats.skipped_ticks.load(std::memory_order_relaxed));
+  scheduler_->ResetMaxTickDuration();
+
+  for (auto [name, queue] : {std::pair{"Connection", &handshake_queue_}, std::pair{"Join", &join_queue_}}) {
+    const auto& queue_stats = queue->GetStats();
+    const auto admitted = queue_stats.admitted.load(std::memory_order_relaxed);
+    if (admitted == 0 && queue->GetSize() == 0) {
+      continue;
     }
+    SPDLOG_DEBUG("{} queue: {} waiting, oldest for {} ms, {} admitted since start after avg {:.1f} ms, max {:.1f} ms", name, queue->GetSize(),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(queue->GetOldestWait(now)).count(), admitted,
+                 queue_stats.total_wait_us.load(std::memory_order_relaxed) / 1000.0 / std::max<std::uint64_t>(admitted, 1),
+                 queue_stats.max_wait_us.load(std::memory_order_relaxed) / 1000.0);
+    queue->ResetMaxWait();
   }
 }
 
@@ -463,6 +608,7 @@ void GameServer::ProcessRespawns() {
       player.flags = 0;
       player.tod = 0;
       player.health = 100;
+      ++player.state_revision;
 
       SendRespawnInfo(player.player_id);
     }
@@ -470,87 +616,39 @@ void GameServer::ProcessRespawns() {
 }
 
 bool GameServer::HandlePacket(Net::ConnectionHandle connectionHandle, unsigned char* data, std::uint32_t size) {
-  Packet p{data, size, connectionHandle};
-
-  unsigned char packetIdentifier = GetPacketIdentifier(p);
-  switch (packetIdentifier) {
-    case ID_DISCONNECTION_NOTIFICATION: {
-      auto player_opt = player_manager_.GetPlayerByConnection(p.id);
-      if (player_opt.has_value()) {
-        SendDisconnectionInfo(player_opt->get().player_id);
-      }
-      HandlePlayerDisconnect(p.id);
-      SPDLOG_INFO("{} disconnected. Still connected {} users.", g_net_server->GetPlayerIp(p.id), player_manager_.GetPlayerCount());
-      break;
-    }
-    case ID_NEW_INCOMING_CONNECTION: {
-      // Add player to the manager
-      PlayerId new_player_id = player_manager_.AddPlayer(p.id, "");
-
-      // Send packet with initial information.
-      InitialInfoPacket packet;
-      packet.packet_type = PT_INITIAL_INFO;
-      packet.map_name = config_.Get<std::string>("map");
-      packet.player_id = new_player_id;
-      SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE, p.id, 9);
-    }
-      SPDLOG_INFO("ID_NEW_INCOMING_CONNECTION from {} with connection {}. Now we have {} connected users.", g_net_server->GetPlayerIp(p.id), p.id,
-                  player_manager_.GetPlayerCount());
-      break;
-    case ID_INCOMPATIBLE_PROTOCOL_VERSION:
-      SPDLOG_WARN("ID_INCOMPATIBLE_PROTOCOL_VERSION");
-      break;
-    case ID_CONNECTION_LOST: {
-      auto player_opt = player_manager_.GetPlayerByConnection(p.id);
-      if (player_opt.has_value()) {
-        SendDisconnectionInfo(player_opt->get().player_id);
-      }
-      HandlePlayerDisconnect(p.id);
-      SPDLOG_WARN("Connection lost from {}. Still connected {} users.", g_net_server->GetPlayerIp(p.id), player_manager_.GetPlayerCount());
-      break;
-    }
-    case PT_REQUEST_FILE_LENGTH:
-    case PT_REQUEST_FILE_PART:
-      break;
-    case PT_JOIN_GAME:
-      SomeoneJoinGame(p);
-      break;
-    case PT_ACTUAL_STATISTICS:  // dostarcza nam informacji o sobie
-      HandlePlayerUpdate(p);
-      break;
-    case PT_HP_DIFF:
-      MakeHPDiff(p);
-      break;
-    case PT_MSG:
-      HandleNormalMsg(p);
-      break;
-    case PT_CASTSPELL:
-      HandleCastSpell(p, false);
-      break;
-    case PT_CASTSPELLONTARGET:
-      HandleCastSpell(p, true);
-      break;
-    case PT_DROPITEM:
-      HandleDropItem(p);
-      break;
-    case PT_TAKEITEM:
-      HandleTakeItem(p);
-      break;
-    case PT_WHISPER:
-      HandleWhisp(p);
-      break;
-    case PT_COMMAND:
-      HandleRMConsole(p);
-      break;
-    case PT_GAME_INFO:  // na razie tylko czas
-      HandleGameInfo(p);
-      break;
-    case PT_VOICE:
-      HandleVoice(p);
+  static constexpr auto kDispatcher = PacketDispatcher<PacketDirection::kToServer, GameServer, const Packet&>::Make(
+      PacketRoute<ID_DISCONNECTION_NOTIFICATION, &GameServer::HandleDisconnection>{},
+      PacketRoute<ID_CONNECTION_LOST, &GameServer::HandleDisconnection>{},
+      PacketRoute<ID_NEW_INCOMING_CONNECTION, &GameServer::HandleNewConnection>{},
+      PacketRoute<ID_INCOMPATIBLE_PROTOCOL_VERSION, &GameServer::HandleIncompatibleProtocol>{},
+      PacketRoute<PT_REQUEST_FILE_LENGTH, &GameServer::HandleFileRequest>{}, PacketRoute<PT_REQUEST_FILE_PART, &GameServer::HandleFileRequest>{},
+      PacketRoute<PT_JOIN_GAME, &GameServer::HandleJoinRequest>{}, PacketRoute<PT_ACTUAL_STATISTICS, &GameServer::HandlePlayerUpdate>{},
+      PacketRoute<PT_HP_DIFF, &GameServer::MakeHPDiff>{}, PacketRoute<PT_MSG, &GameServer::HandleNormalMsg>{},
+      PacketRoute<PT_CASTSPELL, &GameServer::HandleCastSpell>{}, PacketRoute<PT_CASTSPELLONTARGET, &GameServer::HandleCastSpell>{},
+      PacketRoute<PT_DROPITEM, &GameServer::HandleDropItem>{}, PacketRoute<PT_TAKEITEM, &GameServer::HandleTakeItem>{},
+      PacketRoute<PT_WHISPER, &GameServer::HandleWhisp>{}, PacketRoute<PT_COMMAND, &GameServer::HandleRMConsole>{},
+      PacketRoute<PT_GAME_INFO, &GameServer::HandleGameInfo>{}, PacketRoute<PT_VOICE, &GameServer::HandleVoice>{},
+      PacketRoute<PT_SNAPSHOT_ACK, &GameServer::HandleSnapshotAck>{});
+
+  const auto header = ReadPacketHeader(data, size);
+  if (!header) {
+    SPDLOG_WARN("Dropped packet of {} bytes without an id from connection {}", size, connectionHandle);
+    return true;
+  }
+  const std::uint8_t packetIdentifier = header->id;
+  // The handlers decode the packet itself, not the timestamp in front of it.
+  Packet p{data + header->offset, size - header->offset, connectionHandle};
+
+  switch (kDispatcher.Dispatch(*this, packetIdentifier, p.data, p.length, p)) {
+    case DispatchResult::kHandled:
       break;
-    default:
+    case DispatchResult::kUnhandled:
       SPDLOG_WARN("(S)He or it try to do something strange. It's packet ID: {}", packetIdentifier);
       break;
+    case DispatchResult::kMalformed:
+      SPDLOG_WARN("Dropped malformed {} of {} bytes from connection {}", PacketIDToString(static_cast<PacketID>(packetIdentifier)), p.length,
+                  p.id);
+      break;
   }
   return true;
 }
@@ -560,18 +658,49 @@ bool GameServer::Receive() {
   return true;
 }
 
-unsigned char GameServer::GetPacketIdentifier(const Packet& p) {
-  if ((unsigned char)p.data[0] == ID_TIMESTAMP) {
-    return (unsigned char)p.data[1 + sizeof(std::uint32_t)];
-  } else
-    return (unsigned char)p.data[0];
+void GameServer::HandleDisconnection(const Packet& p, Net::RawPacket& packet) {
+  auto player_opt = player_manager_.GetPlayerByConnection(p.id);
+  if (player_opt.has_value()) {
+    SendDisconnectionInfo(player_opt->get().player_id);
+  }
+  HandlePlayerDisconnect(p.id);
+  if (packet.data[0] == ID_CONNECTION_LOST) {
+    SPDLOG_WARN("Connection lost from {}. Still connected {} users.", g_net_server->GetPlayerIp(p.id), player_manager_.GetPlayerCount());
+  } else {
+    SPDLOG_INFO("{} disconnected. Still connected {} users.", g_net_server->GetPlayerIp(p.id), player_manager_.GetPlayerCount());
+  }
+}
+
+void GameServer::HandleNewConnection(const Packet& p, Net::RawPacket&) {
+  // Admitted by ProcessAdmissions, at most max_handshakes_per_tick per tick.
+  handshake_queue_.Push(p.id, {}, AdmissionQueue::Clock::now());
+  SPDLOG_INFO("ID_NEW_INCOMING_CONNECTION from {} with connection {}. {} connections waiting to be admitted.", g_net_server->GetPlayerIp(p.id),
+              p.id, handshake_queue_.GetSize());
+}
+
+void GameServer::HandleIncompatibleProtocol(const Packet&, Net::RawPacket&) {
+  SPDLOG_WARN("ID_INCOMPATIBLE_PROTOCOL_VERSION");
+}
+
+void GameServer::HandleFileRequest(const Packet&, Net::RawPacket&) {
+}
+
+void GameServer::HandleJoinRequest(const Packet& p, JoinGamePacketView&) {
+  // Joins fan out to every player, so they are spread over ticks like new connections.
+  join_queue_.Push(p.id, {p.data, p.length}, AdmissionQueue::Clock::now());
 }
 
 void GameServer::DeleteFromPlayerList(PlayerId player_id) {
+  spatial_grid_.Remove(player_id);
+  snapshot_builder_.RemovePlayer(player_id);
+  state_history_.Remove(player_id);
+  spawn_records_.Remove(player_id);
   player_manager_.RemovePlayer(player_id);
 }
 
 void GameServer::HandlePlayerDisconnect(Net::ConnectionHandle connection) {
+  handshake_queue_.Remove(connection);
+  join_queue_.Remove(connection);
   auto player_opt = player_manager_.GetPlayerByConnection(connection);
   if (player_opt.has_value()) {
     auto& player = player_opt.value().get();
@@ -590,6 +719,7 @@ void GameServer::HandlePlayerDeath(Player& victim, std::optional<PlayerId> kille
   victim.health = 0;
   victim.state.health_points = 0;
   victim.tod = time(NULL);
+  ++victim.state_revision;
 
   if (killer_id.has_value() && killer_id.value() != victim.player_id) {
     EventManager::Instance().TriggerEvent(kEventOnPlayerKillName, OnPlayerKillEvent{killer_id.value(), victim.player_id});
@@ -600,26 +730,24 @@ void GameServer::HandlePlayerDeath(Player& victim, std::optional<PlayerId> kille
   SendDeathInfo(victim.player_id);
 }
 
-void GameServer::SomeoneJoinGame(Packet p) {
-  auto player_opt = player_manager_.GetPlayerByConnection(p.id);
+void GameServer::SomeoneJoinGame(Net::ConnectionHandle connection, JoinGamePacket& packet) {
+  auto player_opt = player_manager_.GetPlayerByConnection(connection);
   if (!player_opt) {
-    SPDLOG_WARN("Someone tried to join game, but he is not on the player list, connection {}!", p.id);
+    SPDLOG_WARN("Someone tried to join game, but he is not on the player list, connection {}!", connection);
     return;
   }
   auto& player = player_opt.value().get();
+  auto& info = player_manager_.GetInfo(player);
 
   if (!allow_modification) {
-    if (!player.passed_crc_test) {
-      player_manager_.RemovePlayerByConnection(p.id);
-      g_net_server->AddToBanList(p.id, 3600000);  // i dorzucamy banana na 1h
+    if (!info.passed_crc_test) {
+      DeleteFromPlayerList(player.player_id);
+      g_net_server->AddToBanList(connection, 3600000);  // i dorzucamy banana na 1h
       return;
     }
   }
 
-  JoinGamePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-  SPDLOG_TRACE("{} from {}", packet, p.id);
+  SPDLOG_TRACE("{} from {}", packet, connection);
 
   bool was_dead = player.tod != 0;
   player.tod = 0;
@@ -632,49 +760,25 @@ void GameServer::SomeoneJoinGame(Packet p) {
   player.state.right_hand_item_instance = packet.right_hand_item_instance;
   player.state.equipped_armor_instance = packet.equipped_armor_instance;
   player.state.animation = packet.animation;
-  player.head = packet.head_model;
-  player.skin = packet.skin_texture;
-  player.body = packet.face_texture;
-  player.walkstyle = packet.walk_style;
-  player.name = packet.player_name;
+  info.head = packet.head_model;
+  info.skin = packet.skin_texture;
+  info.body = packet.face_texture;
+  info.walkstyle = packet.walk_style;
+  info.name = packet.player_name;
+  ++player.state_revision;
+  spawn_records_.Invalidate(player.player_id);
 
   // Update the packet we received with his ID, so we can send it to others.
-  packet.player_id = player.player_id;
-
-  std::vector<ExistingPlayerInfo> existing_players;
-  existing_players.reserve(player_manager_.GetPlayerCount());
+  packet.player_id = player.net_id;
 
-  // Informing other players about new player
-  player_manager_.ForEachPlayer([&](const Player& existing_player) {
-    if (existing_player.player_id != player.player_id) {
-      if (existing_player.is_ingame) {
-        SerializeAndSend(packet, IMMEDIATE_PRIORITY, RELIABLE, existing_player.connection);
-      }
+  // Informing other players about new player. Sent on the join channel, so it can't overtake the existing players pages
+  // those players may still be receiving themselves.
+  SerializeAndBroadcast<PT_JOIN_GAME>(packet, GetIngameConnections(player.player_id));
 
-      ExistingPlayerInfo player_packet;
-      player_packet.player_id = existing_player.player_id;
-      player_packet.position = existing_player.state.position;
-      player_packet.left_hand_item_instance = existing_player.state.left_hand_item_instance;
-      player_packet.right_hand_item_instance = existing_player.state.right_hand_item_instance;
-      player_packet.equipped_armor_instance = existing_player.state.equipped_armor_instance;
-      player_packet.head_model = existing_player.head;
-      player_packet.skin_texture = existing_player.skin;
-      player_packet.face_texture = existing_player.body;
-      player_packet.walk_style = existing_player.walkstyle;
-      player_packet.player_name = existing_player.name;
-      existing_players.push_back(std::move(player_packet));
-    }
-  });
-
-  if (!existing_players.empty()) {
-    // Previously, we were splitting this into mulitple packets. Find out if this is still necessary.
-    ExistingPlayersPacket existing_players_packet;
-    existing_players_packet.packet_type = PT_EXISTING_PLAYERS;
-    existing_players_packet.existing_players = std::move(existing_players);
-    SerializeAndSend(existing_players_packet, IMMEDIATE_PRIORITY, RELIABLE, p.id);
-  }
+  SendExistingPlayers(player);
 
   player.is_ingame = 1;
+  spatial_grid_.Update(player.player_id, player.state.position);
 
   SendDiscordActivity(player.connection);
 
@@ -689,26 +793,90 @@ void GameServer::SomeoneJoinGame(Packet p) {
   EventManager::Instance().TriggerEvent(kEventOnPlayerConnectName, player.player_id);
 }
 
-void GameServer::HandlePlayerUpdate(Packet p) {
-  constexpr double kRadiusSquared = 5000.0 * 5000.0;
+void GameServer::SendExistingPlayers(const Player& joining_player) {
+  const auto& players = player_manager_.GetAllPlayers();
+  join_candidates_.clear();
+  for (std::size_t i = 0; i < players.size(); ++i) {
+    const Player& existing_player = players[i];
+    // Players still loading are announced with their own JoinGame once they are in game.
+    if (existing_player.is_ingame && existing_player.player_id != joining_player.player_id) {
+      const glm::vec3 offset = existing_player.state.position - joining_player.state.position;
+      join_candidates_.push_back({glm::dot(offset, offset), i});
+    }
+  }
+  std::sort(join_candidates_.begin(), join_candidates_.end());
+
+  // Pages are gathered from the cached records behind a header written last, once the player count is known.
+  ExistingPlayersPageHeader header;
+  header.packet_type = PT_EXISTING_PLAYERS;
+  header.last_page = false;
+  auto lease = SendBufferPool::ForCurrentThread().Acquire(kExistingPlayersPageSize);
+  auto& buffer = lease.Get();
+  std::size_t page_size = kExistingPlayersPacketHeaderSize;
+
+  auto send_page = [&]() {
+    bitsery::quickSerialization<SendBufferPool::OutputAdapter>(buffer, header);
+    constexpr auto kTraits = PacketDef<PacketDirection::kToClient, PT_EXISTING_PLAYERS>::kTraits;
+    g_net_server->Send(buffer.data(), static_cast<std::uint32_t>(page_size), kTraits.priority, kTraits.reliability, kTraits.channel,
+                       joining_player.connection);
+    ++header.page;
+    header.count = 0;
+    page_size = kExistingPlayersPacketHeaderSize;
+  };
+
+  for (const auto& [distance_squared, index] : join_candidates_) {
+    const Player& existing_player = players[index];
+    const auto record = spawn_records_.Get(existing_player, player_manager_.GetInfo(existing_player));
+    if (header.count > 0 && (page_size + record.size() > kExistingPlayersPageSize || header.count == kMaxExistingPlayersPerPage)) {
+      send_page();
+    }
 
+    if (buffer.size() < page_size + record.size()) {
+      buffer.resize(page_size + record.size());
+    }
+    std::memcpy(buffer.data() + page_size, record.data(), record.size());
+    page_size += record.size();
+    ++header.count;
+  }
+
+  // Always sent, even when empty, so the client knows the list is complete.
+  header.last_page = true;
+  send_page();
+  SPDLOG_DEBUG("Sent {} existing players in {} pages to player {}", join_candidates_.size(), header.page, joining_player.player_id);
+}
+
+void GameServer::HandlePlayerUpdate(const Packet& p, PlayerStateUpdatePacket& packet) {
   auto player_opt = player_manager_.GetPlayerByConnection(p.id);
   if (!player_opt.has_value()) {
     return;
   }
   auto& updated_player = player_opt.value().get();
 
-  PlayerStateUpdatePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
+  // Health in snapshots comes from the server side value, so the reported one doesn't count as a change.
+  const std::uint16_t changed_fields = GetChangedPlayerStateFields(updated_player.state, packet.state);
+  if (changed_fields & ~PSF_HEALTH_POINTS) {
+    ++updated_player.state_revision;
+  }
+  if (changed_fields & (PSF_LEFT_HAND_ITEM | PSF_RIGHT_HAND_ITEM | PSF_EQUIPPED_ARMOR)) {
+    spawn_records_.Invalidate(updated_player.player_id);
+  }
   updated_player.state = packet.state;
+
+  if (updated_player.is_ingame) {
+    spatial_grid_.Update(updated_player.player_id, updated_player.state.position);
+  }
 }
 
-void GameServer::MakeHPDiff(Packet p) {
-  PlayerId victim_player_id;
-  short diffed_hp;
+void GameServer::HandleSnapshotAck(const Packet& p, SnapshotAckPacket& packet) {
+  auto player_opt = player_manager_.GetPlayerByConnection(p.id);
+  if (!player_opt.has_value()) {
+    return;
+  }
+
+  snapshot_builder_.Acknowledge(player_opt->get().player_id, packet.sequence);
+}
 
+void GameServer::MakeHPDiff(const Packet& p, HPDiffPacket& packet) {
   auto attacker_opt = player_manager_.GetPlayerByConnection(p.id);
   if (!attacker_opt.has_value())
     return;
@@ -716,10 +884,9 @@ void GameServer::MakeHPDiff(Packet p) {
   auto& attacker = attacker_opt.value().get();
 
   if (attacker.is_ingame) {
-    memcpy(&victim_player_id, p.data + 1, sizeof(PlayerId));
-    memcpy(&diffed_hp, p.data + (1 + sizeof(PlayerId)), 2);
+    const std::int16_t diffed_hp = packet.hp_difference;
 
-    auto victim_opt = player_manager_.GetPlayer(victim_player_id);
+    auto victim_opt = player_manager_.GetPlayerByNetId(packet.player_id);
     if (!victim_opt.has_value()) {
       return;
     }
@@ -729,12 +896,23 @@ void GameServer::MakeHPDiff(Packet p) {
       return;
     }
 
+    const std::int16_t previous_health = victim.health;
+
     std::optional<PlayerId> killer_id;
-    if (victim_player_id != attacker.player_id) {
+    if (victim.player_id != attacker.player_id) {
       killer_id = attacker.player_id;
     }
 
-    if (victim_player_id == attacker.player_id) {
+    if (killer_id && !IsHitInRange(attacker, victim)) {
+      SPDLOG_DEBUG("Rejected hit of player {} on player {}, out of range", attacker.player_id, victim.player_id);
+      if (diffed_hp < 0) {
+        EventManager::Instance().TriggerEvent(kEventOnPlayerHitName,
+                                              OnPlayerHitEvent{killer_id, victim.player_id, static_cast<std::int16_t>(-diffed_hp), true});
+      }
+      return;
+    }
+
+    if (victim.player_id == attacker.player_id) {
       if (victim.health) {
         victim.health += diffed_hp;
       }
@@ -751,6 +929,10 @@ void GameServer::MakeHPDiff(Packet p) {
       EventManager::Instance().TriggerEvent(kEventOnPlayerHitName,
                                             OnPlayerHitEvent{killer_id, victim.player_id, static_cast<std::int16_t>(-diffed_hp)});
     }
+    if (killer_id) {
+      // Attacker and victim should see each other first when snapshots are over budget.
+      snapshot_builder_.NoteInteraction(*killer_id, victim.player_id);
+    }
 
     if (victim.health <= 0) {
       HandlePlayerDeath(victim, killer_id);
@@ -759,36 +941,33 @@ void GameServer::MakeHPDiff(Packet p) {
     }
 
     victim.state.health_points = victim.health;
+    if (victim.health != previous_health) {
+      ++victim.state_revision;
+    }
   }
 }
 
-void GameServer::HandleVoice(Packet p) {
+void GameServer::HandleVoice(const Packet& p, Net::RawPacket& packet) {
   // TODO: no need to resend player id right now, it won't be needed until we add 3d chat
-  std::string data;
-  data.reserve(p.length);
-  memcpy(data.data(), p.data, p.length);
-  player_manager_.ForEachIngamePlayer([&](const Player& existing_player) {
-    if (existing_player.connection != p.id) {
-      g_net_server->Send((unsigned char*)data.data(), p.length, IMMEDIATE_PRIORITY, UNRELIABLE, 5, existing_player.connection);
-    }
-  });
+  std::optional<PlayerId> sender_id;
+  if (auto sender_opt = player_manager_.GetPlayerByConnection(p.id); sender_opt.has_value()) {
+    sender_id = sender_opt->get().player_id;
+  }
+  constexpr auto kTraits = PacketDef<PacketDirection::kToClient, PT_VOICE>::kTraits;
+  g_net_server->Broadcast(packet.data, packet.size, kTraits.priority, kTraits.reliability, kTraits.channel, GetIngameConnections(sender_id));
 }
 
-void GameServer::HandleNormalMsg(Packet p) {
+void GameServer::HandleNormalMsg(const Packet& p, MessagePacketView& packet) {
   auto player_opt = player_manager_.GetPlayerByConnection(p.id);
-  if (!player_opt.has_value() || !player_opt.value().get().is_ingame || player_opt.value().get().mute)
+  if (!player_opt.has_value() || !player_opt.value().get().is_ingame || player_manager_.GetInfo(player_opt.value().get()).mute)
     return;
 
   auto& player = player_opt.value().get();
 
-  MessagePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
   if (!packet.message.empty() && packet.message.front() == '/') {
-    auto command = packet.message.substr(1);
+    std::string command(packet.message.substr(1));
     if (!command.empty()) {
-      SPDLOG_INFO("{} issued command: {}", player.name, command);
+      SPDLOG_INFO("{} issued command: {}", player_manager_.GetInfo(player).name, command);
       EventManager::Instance().TriggerEvent(kEventOnPlayerCommandName, OnPlayerCommandEvent{player.player_id, std::move(command)});
     }
     return;
@@ -796,122 +975,97 @@ void GameServer::HandleNormalMsg(Packet p) {
 
   EventManager::Instance().TriggerEvent(kEventOnPlayerMessageName, OnPlayerMessageEvent{player.player_id, packet.message});
 
-  packet.sender = player.player_id;
-  player_manager_.ForEachIngamePlayer(
-      [&](const Player& existing_player) { SerializeAndSend(packet, LOW_PRIORITY, RELIABLE_ORDERED, existing_player.connection); });
+  RelayMessage<PT_MSG>(packet, player.net_id, GetIngameConnections());
 
-  SPDLOG_INFO("{}", packet);
+  SPDLOG_INFO("{}: {}", player_manager_.GetInfo(player).name, packet.message);
 }
 
-void GameServer::HandleWhisp(Packet p) {
+void GameServer::HandleWhisp(const Packet& p, MessagePacketView& packet) {
   auto player_opt = player_manager_.GetPlayerByConnection(p.id);
   if (!player_opt.has_value() || !player_opt.value().get().is_ingame)
     return;
 
   auto& player = player_opt.value().get();
 
-  MessagePacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-
   if (!packet.recipient.has_value()) {
     SPDLOG_ERROR("No recipient in whisper packet!");
     return;
   }
 
-  auto recipient_opt = player_manager_.GetPlayer(*packet.recipient);
+  auto recipient_opt = player_manager_.GetPlayerByNetId(*packet.recipient);
   if (!recipient_opt.has_value())
     return;
   auto& recipient = recipient_opt.value().get();
-  packet.sender = player.player_id;
 
   EventManager::Instance().TriggerEvent(kEventOnPlayerWhisperName, OnPlayerWhisperEvent{player.player_id, recipient.player_id, packet.message});
 
-  SerializeAndSend(packet, LOW_PRIORITY, RELIABLE_ORDERED, player.connection);
-  SerializeAndSend(packet, LOW_PRIORITY, RELIABLE_ORDERED, recipient.connection);
+  const std::array<Net::ConnectionHandle, 2> recipients{player.connection, recipient.connection};
+  RelayMessage<PT_WHISPER>(packet, player.net_id, recipients);
 
-  SPDLOG_INFO("({} WHISPERS TO {}) {}", player.name, recipient.name, (const char*)(p.data + 1 + sizeof(PlayerId)));
+  SPDLOG_INFO("({} WHISPERS TO {}) {}", player_manager_.GetInfo(player).name, player_manager_.GetInfo(recipient).name, packet.message);
 }
 
-void GameServer::HandleCastSpell(Packet p, bool target) {
+void GameServer::HandleCastSpell(const Packet& p, CastSpellPacket& packet) {
   auto player_opt = player_manager_.GetPlayerByConnection(p.id);
   if (!player_opt.has_value() || !player_opt.value().get().is_ingame)
     return;
 
   auto& player = player_opt.value().get();
 
-  CastSpellPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-  packet.caster_id = player.player_id;
+  packet.caster_id = player.net_id;
 
-  if (target) {
+  std::optional<PlayerId> target_id;
+  if (packet.packet_type == PT_CASTSPELLONTARGET) {
     if (!packet.target_id.has_value()) {
       SPDLOG_ERROR("No target in cast spell packet!");
       return;
     }
 
-    auto target_opt = player_manager_.GetPlayer(*packet.target_id);
+    auto target_opt = player_manager_.GetPlayerByNetId(*packet.target_id);
     if (!target_opt.has_value() || !target_opt.value().get().is_ingame) {
       return;
     }
+    target_id = target_opt.value().get().player_id;
   }
 
-  EventManager::Instance().TriggerEvent(kEventOnPlayerCastSpellName, OnPlayerCastSpellEvent{player.player_id, packet.spell_id, packet.target_id});
+  EventManager::Instance().TriggerEvent(kEventOnPlayerCastSpellName, OnPlayerCastSpellEvent{player.player_id, packet.spell_id, target_id});
 
-  player_manager_.ForEachIngamePlayer([&](const Player& existing_player) {
-    if (existing_player.player_id != player.player_id) {
-      SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE, existing_player.connection);
-    }
-  });
+  // Both cast packets are delivered alike.
+  SerializeAndBroadcast<PT_CASTSPELL>(packet, GetIngameConnections(player.player_id));
 }
 
-void GameServer::HandleDropItem(Packet p) {
+void GameServer::HandleDropItem(const Packet& p, DropItemPacket& packet) {
   auto player_opt = player_manager_.GetPlayerByConnection(p.id);
   if (!player_opt.has_value() || !player_opt.value().get().is_ingame)
     return;
 
   auto& player = player_opt.value().get();
 
-  DropItemPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-  packet.player_id = player.player_id;
+  packet.player_id = player.net_id;
 
   EventManager::Instance().TriggerEvent(kEventOnPlayerDropItemName,
                                         OnPlayerDropItemEvent{player.player_id, packet.item_instance, packet.item_amount});
 
-  player_manager_.ForEachIngamePlayer([&](const Player& existing_player) {
-    if (existing_player.player_id != player.player_id) {
-      SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE, existing_player.connection);
-    }
-  });
-  SPDLOG_INFO("{} DROPPED ITEM. AMOUNT: {}", player.name, packet.item_amount);
+  SerializeAndBroadcast<PT_DROPITEM>(packet, GetIngameConnections(player.player_id));
+  SPDLOG_INFO("{} DROPPED ITEM. AMOUNT: {}", player_manager_.GetInfo(player).name, packet.item_amount);
 }
 
-void GameServer::HandleTakeItem(Packet p) {
+void GameServer::HandleTakeItem(const Packet& p, TakeItemPacket& packet) {
   auto player_opt = player_manager_.GetPlayerByConnection(p.id);
   if (!player_opt.has_value() || !player_opt.value().get().is_ingame)
     return;
 
   auto& player = player_opt.value().get();
 
-  TakeItemPacket packet;
-  using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-  auto state = bitsery::quickDeserialization<InputAdapter>({p.data, p.length}, packet);
-  packet.player_id = player.player_id;
+  packet.player_id = player.net_id;
 
   EventManager::Instance().TriggerEvent(kEventOnPlayerTakeItemName, OnPlayerTakeItemEvent{player.player_id, packet.item_instance});
 
-  player_manager_.ForEachIngamePlayer([&](const Player& existing_player) {
-    if (existing_player.player_id != player.player_id) {
-      SerializeAndSend(packet, HIGH_PRIORITY, RELIABLE, existing_player.connection);
-    }
-  });
-  SPDLOG_INFO("{} TOOK ITEM.", player.name);
+  SerializeAndBroadcast<PT_TAKEITEM>(packet, GetIngameConnections(player.player_id));
+  SPDLOG_INFO("{} TOOK ITEM.", player_manager_.GetInfo(player).name);
 }
 
-void GameServer::HandleRMConsole(Packet p) {
+void GameServer::HandleRMConsole(const Packet&, MessagePacketView&) {
   // Intentionally left blank. This can be implemented in the scripts.
 }
 
@@ -978,7 +1132,7 @@ void GameServer::AddToPublicListHTTP() {
   }
 }
 
-void GameServer::HandleGameInfo(Packet p) {
+void GameServer::HandleGameInfo(const Packet& p, Net::RawPacket&) {
   SendGameInfo(p.id);
 }
 
@@ -993,7 +1147,7 @@ void GameServer::SendGameInfo(Net::ConnectionHandle who) {
     packet.flags |= HIDE_MAP;
   }
 
-  SerializeAndSend(packet, MEDIUM_PRIORITY, RELIABLE, who, 9);
+  SerializeAndSend<PT_GAME_INFO>(packet, who);
 }
 
 void GameServer::UpdateDiscordActivity(const DiscordActivityState& activity) {
@@ -1003,7 +1157,7 @@ void GameServer::UpdateDiscordActivity(const DiscordActivityState& activity) {
   SPDLOG_INFO("Discord activity updated: state='{}', details='{}'", discord_activity_.state, discord_activity_.details);
 
   auto packet = MakeDiscordActivityPacket(discord_activity_);
-  player_manager_.ForEachIngamePlayer([&](const Player& player) { SerializeAndSend(packet, LOW_PRIORITY, RELIABLE, player.connection); });
+  SerializeAndBroadcast<PT_DISCORD_ACTIVITY>(packet, GetIngameConnections());
 }
 
 const GameServer::DiscordActivityState& GameServer::GetDiscordActivity() const {
@@ -1016,22 +1170,15 @@ void GameServer::SendDiscordActivity(Net::ConnectionHandle handle) {
   }
 
   auto packet = MakeDiscordActivityPacket(discord_activity_);
-  SerializeAndSend(packet, LOW_PRIORITY, RELIABLE, handle);
-}
-
-void GameServer::HandleMapNameReq(Packet p) {
+  SerializeAndSend<PT_DISCORD_ACTIVITY>(packet, handle);
 }
 
 void GameServer::SendDisconnectionInfo(PlayerId disconnected_player_id) {
   DisconnectionInfoPacket packet;
-  packet.disconnected_id = disconnected_player_id;
+  packet.disconnected_id = player_manager_.GetNetId(disconnected_player_id).value_or(0);
   packet.packet_type = PT_LEFT_GAME;
 
-  player_manager_.ForEachIngamePlayer([&](const Player& player) {
-    if (player.player_id != disconnected_player_id) {
-      SerializeAndSend(packet, IMMEDIATE_PRIORITY, RELIABLE, player.connection);
-    }
-  });
+  SerializeAndBroadcast<PT_LEFT_GAME>(packet, GetIngameConnections(disconnected_player_id));
 }
 
 bool GameServer::IsPublic() {
@@ -1047,23 +1194,23 @@ void GameServer::SendServerMessage(const std::string& message) {
   packet.packet_type = PT_SRVMSG;
   packet.message = message;
 
-  player_manager_.ForEachIngamePlayer([&](const Player& player) { SerializeAndSend(packet, MEDIUM_PRIORITY, RELIABLE, player.connection, 11); });
+  SerializeAndBroadcast<PT_SRVMSG>(packet, GetIngameConnections());
 }
 
 void GameServer::SendDeathInfo(PlayerId dead_player_id) {
   PlayerDeathInfoPacket packet;
   packet.packet_type = PT_DODIE;
-  packet.player_id = dead_player_id;
+  packet.player_id = player_manager_.GetNetId(dead_player_id).value_or(0);
 
-  player_manager_.ForEachIngamePlayer([&](const Player& player) { SerializeAndSend(packet, IMMEDIATE_PRIORITY, RELIABLE, player.connection, 13); });
+  SerializeAndBroadcast<PT_DODIE>(packet, GetIngameConnections());
 }
 
 void GameServer::SendRespawnInfo(PlayerId respawned_player_id) {
   PlayerRespawnInfoPacket packet;
   packet.packet_type = PT_RESPAWN;
-  packet.player_id = respawned_player_id;
+  packet.player_id = player_manager_.GetNetId(respawned_player_id).value_or(0);
 
-  player_manager_.ForEachIngamePlayer([&](const Player& player) { SerializeAndSend(packet, IMMEDIATE_PRIORITY, RELIABLE, player.connection, 13); });
+  SerializeAndBroadcast<PT_RESPAWN>(packet, GetIngameConnections());
 }
 
 std::uint32_t GameServer::GetPort() const {
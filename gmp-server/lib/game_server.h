@@ -29,21 +29,32 @@ SOFTWARE.
 #include <string.h>
 
 #include <atomic>
+#include <chrono>
 #include <ctime>
 #include <functional>
 #include <future>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Script.h"
+#include "admission_queue.h"
 #include "ban_manager.h"
 #include "common_structs.h"
 #include "config.h"
+#include "packet_registry.h"
 #include "player_manager.h"
+#include "snapshot_builder.h"
+#include "spawn_record_cache.h"
+#include "spatial_grid.h"
+#include "state_history.h"
+#include "tick_scheduler.h"
+#include "worker_pool.h"
 #include "znet_server.h"
 
 #define DEFAULT_ADMIN_PORT 0x404
@@ -85,7 +96,8 @@ public:
   void AddToPublicListHTTP();
   bool Receive();
   bool HandlePacket(Net::ConnectionHandle connectionHandle, unsigned char* data, std::uint32_t size);
-  void Run();
+  // Runs a single simulation tick. Called by the scheduler every tick_rate_ms.
+  void Tick();
   bool Init();
   bool IsPublic(void);
   void SendServerMessage(const std::string& message);
@@ -98,27 +110,94 @@ public:
 
   std::uint32_t GetPort() const;
 
+  /**
+   * @brief Gets the tick duration and overrun counters of the main loop
+   * @return nullptr before Init
+   */
+  const TickScheduler::Stats* GetTickStats() const {
+    return scheduler_ ? &scheduler_->GetStats() : nullptr;
+  }
+
+  /**
+   * @brief Gets the queue of new connections waiting for their InitialInfo, see max_handshakes_per_tick
+   */
+  const AdmissionQueue& GetHandshakeQueue() const {
+    return handshake_queue_;
+  }
+
+  /**
+   * @brief Gets the queue of join requests waiting to be processed, see max_joins_per_tick
+   */
+  const AdmissionQueue& GetJoinQueue() const {
+    return join_queue_;
+  }
+
 private:
+  // Grid cell size until Init resizes the grid to the configured lod_near_radius.
+  static constexpr float kDefaultGridCellSize = 5000.0f;
+  static constexpr std::chrono::seconds kSnapshotStatsInterval{60};
+  // Lower bound of the adaptive budget, so the closest players still get through on a congested link.
+  static constexpr std::size_t kMinSnapshotByteBudget = 256;
+  // Recipients are split into this many chunks per snapshot thread, so threads that finish early can help out.
+  static constexpr std::size_t kSnapshotChunksPerWorker = 4;
+  // States kept per player until Init sizes the history to lag_compensation_ms.
+  static constexpr std::size_t kDefaultStateHistorySamples = 11;
+  // Serialized size limit of a single existing players page, so a page fits into one datagram.
+  static constexpr std::size_t kExistingPlayersPageSize = 1200;
+  // Queued clients learn their position right away, then at most this often while it changes.
+  static constexpr std::chrono::seconds kQueuePositionInterval{2};
+
+  // Snapshot entry counts accumulated since `since`, logged together with the tick budget every kSnapshotStatsInterval.
+  struct SnapshotStats {
+    std::chrono::steady_clock::time_point since{};
+    std::uint64_t ticks = 0;
+    std::uint64_t sent_states = 0;
+    std::uint64_t suppressed_states = 0;
+    std::uint64_t deferred_entries = 0;
+  };
+
   void DeleteFromPlayerList(PlayerId player_id);
-  void HandleCastSpell(Packet p, bool target);
-  void HandleDropItem(Packet p);
-  void HandleTakeItem(Packet p);
-  void HandleVoice(Packet p);
-  void SomeoneJoinGame(Packet p);
-  void HandlePlayerUpdate(Packet p);
-  void MakeHPDiff(Packet p);
+  // Admits up to the configured number of queued connections and join requests, and tells the rest where they are.
+  void ProcessAdmissions();
+  void AdmitConnection(Net::ConnectionHandle connection);
+  void SendQueuePosition(Net::ConnectionHandle connection, std::size_t position, std::size_t queue_size);
+  // Packet handlers, bound to their packet ids in HandlePacket. They get the packet already decoded as registered in packet_registry.h.
+  void HandleDisconnection(const Packet& p, Net::RawPacket& packet);
+  void HandleNewConnection(const Packet& p, Net::RawPacket& packet);
+  void HandleIncompatibleProtocol(const Packet& p, Net::RawPacket& packet);
+  void HandleFileRequest(const Packet& p, Net::RawPacket& packet);
+  void HandleJoinRequest(const Packet& p, Net::JoinGamePacketView& packet);
+  void HandleCastSpell(const Packet& p, CastSpellPacket& packet);
+  void HandleDropItem(const Packet& p, DropItemPacket& packet);
+  void HandleTakeItem(const Packet& p, TakeItemPacket& packet);
+  void HandleVoice(const Packet& p, Net::RawPacket& packet);
+  void HandlePlayerUpdate(const Packet& p, PlayerStateUpdatePacket& packet);
+  void HandleSnapshotAck(const Packet& p, SnapshotAckPacket& packet);
+  void MakeHPDiff(const Packet& p, HPDiffPacket& packet);
+  void HandleNormalMsg(const Packet& p, Net::MessagePacketView& packet);
+  void HandleWhisp(const Packet& p, Net::MessagePacketView& packet);
+  void HandleRMConsole(const Packet& p, Net::MessagePacketView& packet);
+  void HandleGameInfo(const Packet& p, Net::RawPacket& packet);
+  void SomeoneJoinGame(Net::ConnectionHandle connection, JoinGamePacket& packet);
+  // Sends all in-game players to the joining player in pages of at most kExistingPlayersPageSize bytes, nearest first.
+  // The pages are gathered from spawn_records_.
+  void SendExistingPlayers(const Player& joining_player);
   void HandlePlayerDisconnect(Net::ConnectionHandle connection);
   void HandlePlayerDeath(Player& victim, std::optional<PlayerId> killer_id);
-  void HandleNormalMsg(Packet p);
-  void HandleWhisp(Packet p);
-  void HandleRMConsole(Packet p);
-  void HandleGameInfo(Packet p);
-  void HandleMapNameReq(Packet p);
   void SendDisconnectionInfo(PlayerId player_id);
   void SendDeathInfo(PlayerId player_id);
   void SendRespawnInfo(PlayerId player_id);
   void SendGameInfo(Net::ConnectionHandle connection);
   void SendDiscordActivity(Net::ConnectionHandle connection);
+  void SendSnapshots();
+  // Configured snapshot budget, reduced to what the connection currently manages to send.
+  std::size_t GetSnapshotByteBudget(Net::ConnectionHandle connection);
+  void LogServerStats();
+  void RecordStateHistory();
+  // Whether the victim was within max_hit_distance of the attacker at the time the attacker saw it, estimated from the attacker's ping.
+  bool IsHitInRange(const Player& attacker, const Player& victim) const;
+  // Connections of all in-game players except `excluded`. The returned span is valid until the next call.
+  std::span<const Net::ConnectionHandle> GetIngameConnections(std::optional<PlayerId> excluded = std::nullopt);
 
   std::unique_ptr<BanManager> ban_manager_;
   std::unique_ptr<Script> script;
@@ -127,16 +206,41 @@ private:
 
   void ProcessRespawns();
 
-  unsigned char GetPacketIdentifier(const Packet& p);
   int serverPort;
   unsigned short maxConnections;
   PlayerManager player_manager_;
+  SpatialGrid spatial_grid_{kDefaultGridCellSize};
+  SnapshotBuilder snapshot_builder_{player_manager_, spatial_grid_};
+  SnapshotStats snapshot_stats_{};
+  StateHistory state_history_{kDefaultStateHistorySamples};
+  SpawnRecordCache spawn_records_;
+  AdmissionQueue handshake_queue_;
+  AdmissionQueue join_queue_;
+  // 0 means no limit.
+  std::size_t max_handshakes_per_tick_{0};
+  std::size_t max_joins_per_tick_{0};
+  std::chrono::steady_clock::time_point last_queue_position_report_{};
+  // 0 disables the hit distance check.
+  float max_hit_distance_{0.0f};
+  std::chrono::milliseconds lag_compensation_window_{0};
+  std::size_t snapshot_byte_budget_{SnapshotBuilder::kNoByteBudget};
+  bool adaptive_snapshot_budget_{true};
+  // Reused by GetIngameConnections so broadcasts don't allocate a recipient list each time.
+  std::vector<Net::ConnectionHandle> broadcast_recipients_;
+  // Squared distance to the joining player and index into GetAllPlayers, reused by SendExistingPlayers.
+  std::vector<std::pair<float, std::size_t>> join_candidates_;
   bool allow_modification = false;
   Config config_;
   std::unique_ptr<GothicClock> clock_;
   std::unique_ptr<HTTPServer> http_server_;
   std::future<void> public_list_http_thread_future_;
-  std::chrono::time_point<std::chrono::steady_clock> last_update_time_{};
+  std::unique_ptr<TickScheduler> scheduler_;
+  std::unique_ptr<WorkerPool> worker_pool_;
+  // One reusable packet per snapshot thread.
+  std::vector<SnapshotPacket> snapshot_packets_;
+  // Counted from Init, sent with every snapshot.
+  std::uint32_t server_tick_{0};
+  std::chrono::steady_clock::time_point start_time_{};
   std::thread main_thread;
   std::atomic<bool> main_thread_running = false;
   DiscordActivityState discord_activity_{};
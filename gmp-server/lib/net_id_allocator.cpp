@@ -0,0 +1,60 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "net_id_allocator.h"
+
+NetIdAllocator::NetIdAllocator(Clock::duration quarantine) : quarantine_(quarantine) {
+}
+
+std::optional<NetId> NetIdAllocator::Allocate(Clock::time_point now) {
+  // Reusing ids keeps them small, so tables indexed by them stay compact.
+  if (!released_.empty() && now - released_.front().time >= quarantine_) {
+    const NetId id = released_.front().id;
+    released_.pop_front();
+    return id;
+  }
+
+  if (next_fresh_id_ != 0) {
+    const auto id = static_cast<NetId>(next_fresh_id_);
+    next_fresh_id_ = next_fresh_id_ == kMaxIds ? 0 : next_fresh_id_ + 1;
+    return id;
+  }
+
+  if (released_.empty()) {
+    return std::nullopt;
+  }
+  // The oldest id is still the safest one to reuse early, rather than refusing the player.
+  const NetId id = released_.front().id;
+  released_.pop_front();
+  return id;
+}
+
+void NetIdAllocator::Release(NetId id, Clock::time_point now) {
+  released_.push_back(Released{id, now});
+}
+
+void NetIdAllocator::Clear() {
+  next_fresh_id_ = 1;
+  released_.clear();
+}
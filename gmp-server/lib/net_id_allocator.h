@@ -0,0 +1,79 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+#include "common_structs.h"
+
+/**
+ * @brief Hands out the NetIds players are known by on the wire
+ *
+ * A released id is quarantined before it is handed out again, so packets about a player that left,
+ * still in flight or queued, can't be mistaken for the player who gets the id next. Ids whose
+ * quarantine is over are reused before new ones are taken, which keeps the ids small, and the
+ * quarantine is only cut short when no other id is left.
+ */
+class NetIdAllocator {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Ids available in total, 0 is not one of them.
+  static constexpr std::size_t kMaxIds = 0xFFFF;
+
+  explicit NetIdAllocator(Clock::duration quarantine);
+
+  /**
+   * @brief Takes a free id
+   * @return std::nullopt if all kMaxIds ids are in use
+   */
+  std::optional<NetId> Allocate(Clock::time_point now);
+
+  /**
+   * @brief Returns an id, it becomes available again after the quarantine period
+   */
+  void Release(NetId id, Clock::time_point now);
+
+  /**
+   * @brief Forgets all ids, including the quarantined ones
+   */
+  void Clear();
+
+private:
+  struct Released {
+    NetId id;
+    Clock::time_point time;
+  };
+
+  Clock::duration quarantine_;
+  // Next id that was never handed out, 0 once all were.
+  std::uint32_t next_fresh_id_{1};
+  // Ordered by release time, so the front is the first one to leave quarantine.
+  std::deque<Released> released_;
+};
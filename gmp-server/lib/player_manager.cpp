@@ -25,45 +25,86 @@ SOFTWARE.
 #include "player_manager.h"
 
 PlayerManager::PlayerId PlayerManager::AddPlayer(Net::ConnectionHandle connection, const std::string& name) {
-  PlayerId player_id = next_player_id_++;
+  std::uint32_t slot;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    assert(slots_.size() < kMaxPlayers);
+    slot = static_cast<std::uint32_t>(slots_.size());
+    slots_.emplace_back();
+  }
+  slots_[slot].index = static_cast<std::uint32_t>(players_.size());
+  const PlayerId player_id = (PlayerId{slots_[slot].generation} << kSlotBits) | slot;
+
+  // Can't run out, there are as many NetIds as players.
+  const NetId net_id = *net_ids_.Allocate(NetIdAllocator::Clock::now());
+  if (net_id >= net_id_to_player_.size()) {
+    net_id_to_player_.resize(net_id + std::size_t{1});
+  }
+  net_id_to_player_[net_id] = player_id;
 
-  Player player{};
+  Player& player = players_.emplace_back();
   player.player_id = player_id;
   player.connection = connection;
-  player.name = name;
-  player.head = 0;
-  player.skin = 0;
-  player.body = 0;
+  player.net_id = net_id;
   player.flags = 0;
-  player.walkstyle = 0;
-  player.fight_pos = 0;
-  player.spellhand = 0;
-  player.headstate = 0;
   player.is_ingame = 0;
-  player.passed_crc_test = 0;
-  player.mute = 0;
   player.health = 0;
   player.mana = 0;
   player.tod = 0;
+  player.state_revision = 0;
+
+  PlayerInfo& info = infos_.emplace_back();
+  info.name = name;
+  info.head = 0;
+  info.skin = 0;
+  info.body = 0;
+  info.walkstyle = 0;
+  info.fight_pos = 0;
+  info.spellhand = 0;
+  info.headstate = 0;
+  info.passed_crc_test = 0;
+  info.mute = 0;
 
-  players_[player_id] = std::move(player);
-  player_to_connection_[player_id] = connection;
   connection_to_player_[connection] = player_id;
 
   return player_id;
 }
 
+void PlayerManager::Reserve(std::size_t count) {
+  players_.reserve(count);
+  infos_.reserve(count);
+  slots_.reserve(count);
+  free_slots_.reserve(count);
+  connection_to_player_.reserve(count);
+}
+
 bool PlayerManager::RemovePlayer(PlayerId player_id) {
-  auto it = players_.find(player_id);
-  if (it == players_.end()) {
+  const std::uint32_t index = FindIndex(player_id);
+  if (index == kNoIndex) {
     return false;
   }
 
-  Net::ConnectionHandle connection = it->second.connection;
+  connection_to_player_.erase(players_[index].connection);
+  net_id_to_player_[players_[index].net_id] = 0;
+  net_ids_.Release(players_[index].net_id, NetIdAllocator::Clock::now());
+
+  // Keep the array dense by moving the last player into the gap.
+  if (index != players_.size() - 1) {
+    players_[index] = players_.back();
+    infos_[index] = std::move(infos_.back());
+    slots_[players_[index].player_id & kSlotMask].index = index;
+  }
+  players_.pop_back();
+  infos_.pop_back();
 
-  players_.erase(it);
-  player_to_connection_.erase(player_id);
-  connection_to_player_.erase(connection);
+  Slot& slot = slots_[player_id & kSlotMask];
+  slot.index = kNoIndex;
+  if (++slot.generation == 0) {
+    slot.generation = 1;
+  }
+  free_slots_.push_back(player_id & kSlotMask);
 
   return true;
 }
@@ -79,19 +120,19 @@ bool PlayerManager::RemovePlayerByConnection(Net::ConnectionHandle connection) {
 }
 
 std::optional<std::reference_wrapper<PlayerManager::Player>> PlayerManager::GetPlayer(PlayerId player_id) {
-  auto it = players_.find(player_id);
-  if (it == players_.end()) {
+  const std::uint32_t index = FindIndex(player_id);
+  if (index == kNoIndex) {
     return std::nullopt;
   }
-  return std::ref(it->second);
+  return std::ref(players_[index]);
 }
 
 std::optional<std::reference_wrapper<const PlayerManager::Player>> PlayerManager::GetPlayer(PlayerId player_id) const {
-  auto it = players_.find(player_id);
-  if (it == players_.end()) {
+  const std::uint32_t index = FindIndex(player_id);
+  if (index == kNoIndex) {
     return std::nullopt;
   }
-  return std::cref(it->second);
+  return std::cref(players_[index]);
 }
 
 std::optional<std::reference_wrapper<PlayerManager::Player>> PlayerManager::GetPlayerByConnection(Net::ConnectionHandle connection) {
@@ -110,12 +151,34 @@ std::optional<std::reference_wrapper<const PlayerManager::Player>> PlayerManager
   return GetPlayer(it->second);
 }
 
+std::optional<std::reference_wrapper<PlayerManager::Player>> PlayerManager::GetPlayerByNetId(NetId net_id) {
+  if (net_id >= net_id_to_player_.size() || net_id_to_player_[net_id] == 0) {
+    return std::nullopt;
+  }
+  return GetPlayer(net_id_to_player_[net_id]);
+}
+
+std::optional<std::reference_wrapper<const PlayerManager::Player>> PlayerManager::GetPlayerByNetId(NetId net_id) const {
+  if (net_id >= net_id_to_player_.size() || net_id_to_player_[net_id] == 0) {
+    return std::nullopt;
+  }
+  return GetPlayer(net_id_to_player_[net_id]);
+}
+
+std::optional<NetId> PlayerManager::GetNetId(PlayerId player_id) const {
+  const std::uint32_t index = FindIndex(player_id);
+  if (index == kNoIndex) {
+    return std::nullopt;
+  }
+  return players_[index].net_id;
+}
+
 std::optional<Net::ConnectionHandle> PlayerManager::GetConnectionHandle(PlayerId player_id) const {
-  auto it = player_to_connection_.find(player_id);
-  if (it == player_to_connection_.end()) {
+  const std::uint32_t index = FindIndex(player_id);
+  if (index == kNoIndex) {
     return std::nullopt;
   }
-  return it->second;
+  return players_[index].connection;
 }
 
 std::optional<PlayerManager::PlayerId> PlayerManager::GetPlayerId(Net::ConnectionHandle connection) const {
@@ -125,3 +188,22 @@ std::optional<PlayerManager::PlayerId> PlayerManager::GetPlayerId(Net::Connectio
   }
   return it->second;
 }
+
+void PlayerManager::Clear() {
+  players_.clear();
+  infos_.clear();
+  // Slots keep their generations, so IDs handed out before stay stale.
+  free_slots_.clear();
+  for (std::uint32_t slot = 0; slot < slots_.size(); ++slot) {
+    if (slots_[slot].index != kNoIndex) {
+      slots_[slot].index = kNoIndex;
+      if (++slots_[slot].generation == 0) {
+        slots_[slot].generation = 1;
+      }
+    }
+    free_slots_.push_back(slot);
+  }
+  connection_to_player_.clear();
+  net_ids_.Clear();
+  net_id_to_player_.clear();
+}
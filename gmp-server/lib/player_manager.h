@@ -24,14 +24,18 @@ SOFTWARE.
 
 #pragma once
 
+#include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <ctime>
 #include <functional>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "common_structs.h"
+#include "net_id_allocator.h"
 #include "znet_server.h"
 
 /**
@@ -39,6 +43,16 @@ SOFTWARE.
  *
  * PlayerManager maintains the mapping between network connections and game-level
  * player IDs, and handles player lifecycle (join, leave, state management).
+ *
+ * Players are stored in a slot map: a dense array that is iterated linearly, plus a slot
+ * table translating IDs into array positions. An ID combines the slot with the generation
+ * it was handed out in, so an ID kept by a script after its player left is recognized as
+ * stale even when the slot is in use again. Removing a player moves the last one into the
+ * gap, so references to players are only valid until the next AddPlayer or RemovePlayer.
+ * Rarely used data is kept in a separate PlayerInfo array, in the same order as the players.
+ *
+ * Packets don't carry the PlayerId but a 16-bit NetId, see NetIdAllocator. Only the translation
+ * at the packet boundary deals with it, scripts and logs keep using the PlayerId.
  */
 class PlayerManager {
 public:
@@ -51,10 +65,31 @@ public:
 
   /**
    * @brief Represents a player in the game
+   *
+   * Only holds what the tick loops read for every player, so more players fit into each cache line.
+   * Identity and appearance live in PlayerInfo, see GetInfo.
    */
   struct Player {
-    PlayerId player_id;
     Net::ConnectionHandle connection;
+    std::time_t tod;  // time of death
+    PlayerId player_id;
+    // Bumped whenever something that ends up in snapshots changes, so unchanged players are not re-sent.
+    std::uint32_t state_revision;
+
+    std::int16_t health;
+    std::int16_t mana;
+    std::uint8_t is_ingame;
+    std::uint8_t flags;
+    // Identifies the player in packets.
+    NetId net_id;
+
+    PlayerState state;
+  };
+
+  /**
+   * @brief Identity and appearance of a player, only needed when players join, chat or are listed
+   */
+  struct PlayerInfo {
     std::string name;
 
     // Character appearance
@@ -63,24 +98,20 @@ public:
     std::uint8_t body;
 
     // Character state
-    std::uint8_t flags;
     std::uint8_t walkstyle;
     std::uint8_t fight_pos;
     std::uint8_t spellhand;
     std::uint8_t headstate;
 
-    // Game state
-    std::uint8_t is_ingame;
     std::uint8_t passed_crc_test;
     std::uint8_t mute;
-
-    std::int16_t health;
-    std::int16_t mana;
-
-    std::time_t tod;  // time of death
-    PlayerState state;
   };
 
+  // Most players that can exist at once, limited by the NetIds available.
+  static constexpr std::size_t kMaxPlayers = NetIdAllocator::kMaxIds;
+  // How long the NetId of a player who left is not given to anyone else, if possible.
+  static constexpr std::chrono::seconds kNetIdQuarantine{10};
+
   PlayerManager() = default;
   ~PlayerManager() = default;
 
@@ -92,10 +123,16 @@ public:
    * @brief Adds a new player with the given connection handle
    * @param connection The network connection handle
    * @param name The player's name
-   * @return The assigned player ID
+   * @return The assigned player ID, never 0
    */
   PlayerId AddPlayer(Net::ConnectionHandle connection, const std::string& name);
 
+  /**
+   * @brief Preallocates room for a number of players, so adding them moves no other player in memory
+   * @param count Expected peak player count
+   */
+  void Reserve(std::size_t count);
+
   /**
    * @brief Removes a player by their player ID
    * @param player_id The player ID to remove
@@ -124,6 +161,18 @@ public:
    */
   std::optional<std::reference_wrapper<const Player>> GetPlayer(PlayerId player_id) const;
 
+  /**
+   * @brief Gets the identity and appearance of a player
+   * @param player A player owned by this manager
+   */
+  PlayerInfo& GetInfo(const Player& player) {
+    return infos_[GetIndex(player)];
+  }
+
+  const PlayerInfo& GetInfo(const Player& player) const {
+    return infos_[GetIndex(player)];
+  }
+
   /**
    * @brief Gets a player by their connection handle
    * @param connection The connection handle
@@ -138,6 +187,27 @@ public:
    */
   std::optional<std::reference_wrapper<const Player>> GetPlayerByConnection(Net::ConnectionHandle connection) const;
 
+  /**
+   * @brief Gets a player by the id used in packets
+   * @param net_id The NetId
+   * @return Optional reference to the player if found
+   */
+  std::optional<std::reference_wrapper<Player>> GetPlayerByNetId(NetId net_id);
+
+  /**
+   * @brief Gets a const player by the id used in packets
+   * @param net_id The NetId
+   * @return Optional const reference to the player if found
+   */
+  std::optional<std::reference_wrapper<const Player>> GetPlayerByNetId(NetId net_id) const;
+
+  /**
+   * @brief Gets the id used in packets for a player ID
+   * @param player_id The player ID
+   * @return Optional NetId if found
+   */
+  std::optional<NetId> GetNetId(PlayerId player_id) const;
+
   /**
    * @brief Gets the connection handle for a player ID
    * @param player_id The player ID
@@ -154,9 +224,9 @@ public:
 
   /**
    * @brief Gets all players
-   * @return Const reference to the players map
+   * @return Const reference to the dense player array, in no particular order
    */
-  const std::unordered_map<PlayerId, Player>& GetAllPlayers() const {
+  const std::vector<Player>& GetAllPlayers() const {
     return players_;
   }
 
@@ -174,7 +244,7 @@ public:
    * @return true if the player exists, false otherwise
    */
   bool HasPlayer(PlayerId player_id) const {
-    return players_.find(player_id) != players_.end();
+    return FindIndex(player_id) != kNoIndex;
   }
 
   /**
@@ -192,7 +262,7 @@ public:
    */
   template <typename Func>
   void ForEachPlayer(Func&& func) {
-    for (auto& [id, player] : players_) {
+    for (auto& player : players_) {
       func(player);
     }
   }
@@ -203,7 +273,7 @@ public:
    */
   template <typename Func>
   void ForEachPlayer(Func&& func) const {
-    for (const auto& [id, player] : players_) {
+    for (const auto& player : players_) {
       func(player);
     }
   }
@@ -214,7 +284,7 @@ public:
    */
   template <typename Func>
   void ForEachIngamePlayer(Func&& func) {
-    for (auto& [id, player] : players_) {
+    for (auto& player : players_) {
       if (player.is_ingame) {
         func(player);
       }
@@ -227,7 +297,7 @@ public:
    */
   template <typename Func>
   void ForEachIngamePlayer(Func&& func) const {
-    for (const auto& [id, player] : players_) {
+    for (const auto& player : players_) {
       if (player.is_ingame) {
         func(player);
       }
@@ -237,16 +307,43 @@ public:
   /**
    * @brief Clears all players
    */
-  void Clear() {
-    players_.clear();
-    player_to_connection_.clear();
-    connection_to_player_.clear();
-    next_player_id_ = 1;
-  }
+  void Clear();
 
 private:
-  PlayerId next_player_id_ = 1;
-  std::unordered_map<PlayerId, Player> players_;
-  std::unordered_map<PlayerId, Net::ConnectionHandle> player_to_connection_;
+  static constexpr std::uint32_t kSlotBits = 16;
+  static constexpr PlayerId kSlotMask = (PlayerId{1} << kSlotBits) - 1;
+  static constexpr std::uint32_t kNoIndex = 0xFFFFFFFF;
+
+  struct Slot {
+    // Position of the player in players_, kNoIndex while the slot is free.
+    std::uint32_t index{kNoIndex};
+    // Bumped whenever the slot is freed, never 0 so no ID is 0.
+    std::uint16_t generation{1};
+  };
+
+  // Position of a live player in players_, or kNoIndex for unknown and stale IDs.
+  std::uint32_t FindIndex(PlayerId player_id) const {
+    const PlayerId slot = player_id & kSlotMask;
+    if (slot >= slots_.size() || slots_[slot].generation != (player_id >> kSlotBits)) {
+      return kNoIndex;
+    }
+    return slots_[slot].index;
+  }
+
+  // Position of a player within players_ and infos_.
+  std::size_t GetIndex(const Player& player) const {
+    assert(&player >= players_.data() && &player < players_.data() + players_.size());
+    return static_cast<std::size_t>(&player - players_.data());
+  }
+
+  std::vector<Player> players_;
+  // Parallel to players_.
+  std::vector<PlayerInfo> infos_;
+  std::vector<Slot> slots_;
+  // Slots available for reuse, taken from the back.
+  std::vector<std::uint32_t> free_slots_;
   std::unordered_map<Net::ConnectionHandle, PlayerId> connection_to_player_;
+  NetIdAllocator net_ids_{kNetIdQuarantine};
+  // Indexed by NetId, 0 for ids not in use.
+  std::vector<PlayerId> net_id_to_player_;
 };
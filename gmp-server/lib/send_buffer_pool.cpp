@@ -0,0 +1,77 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "send_buffer_pool.h"
+
+#include <algorithm>
+
+SendBufferPool::SendBufferPool() {
+  // Releasing must not allocate either.
+  for (auto& free_list : free_buffers_) {
+    free_list.reserve(kMaxFreeBuffersPerClass);
+  }
+}
+
+SendBufferPool& SendBufferPool::ForCurrentThread() {
+  thread_local SendBufferPool pool;
+  return pool;
+}
+
+std::size_t SendBufferPool::GetSizeClass(std::size_t size) {
+  for (std::size_t size_class = 0; size_class < kSizeClasses.size(); ++size_class) {
+    if (size <= kSizeClasses[size_class]) {
+      return size_class;
+    }
+  }
+  return kSizeClasses.size() - 1;
+}
+
+SendBufferPool::Lease SendBufferPool::Acquire(std::size_t min_size) {
+  for (std::size_t size_class = GetSizeClass(min_size); size_class < kSizeClasses.size(); ++size_class) {
+    auto& free_list = free_buffers_[size_class];
+    if (!free_list.empty() && free_list.back().size() >= min_size) {
+      Buffer buffer = std::move(free_list.back());
+      free_list.pop_back();
+      return Lease(*this, std::move(buffer));
+    }
+  }
+
+  ++allocations_;
+  Buffer buffer;
+  buffer.resize(std::max(min_size, kSizeClasses[GetSizeClass(min_size)]));
+  return Lease(*this, std::move(buffer));
+}
+
+void SendBufferPool::Release(Buffer buffer) {
+  // File it under the largest class it can fully serve; bitsery may have grown it past its original class.
+  std::size_t size_class = GetSizeClass(buffer.size());
+  if (size_class > 0 && buffer.size() < kSizeClasses[size_class]) {
+    --size_class;
+  }
+
+  auto& free_list = free_buffers_[size_class];
+  if (free_list.size() < kMaxFreeBuffersPerClass) {
+    free_list.push_back(std::move(buffer));
+  }
+}
@@ -0,0 +1,118 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/bitsery.h>
+#include <bitsery/traits/vector.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Recycles the byte buffers packets are serialized into before being sent.
+ *
+ * Buffers are kept in free lists by size class. A released buffer keeps its size, so once a
+ * buffer grew to fit the largest snapshot it is reused as is and serializing stops allocating.
+ * Pools are not thread-safe, ForCurrentThread gives every thread its own.
+ */
+class SendBufferPool {
+public:
+  using Buffer = std::vector<std::uint8_t>;
+  using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
+
+  // Events and chat, join and existing player info, snapshots of a crowded area, anything larger.
+  static constexpr std::array<std::size_t, 4> kSizeClasses{128, 1024, 4096, 16384};
+  // Released buffers beyond this are freed, so a burst does not pin memory forever.
+  static constexpr std::size_t kMaxFreeBuffersPerClass = 16;
+
+  /**
+   * @brief A buffer borrowed from the pool, returned when the lease is destroyed
+   */
+  class Lease {
+  public:
+    Lease(SendBufferPool& pool, Buffer buffer) : pool_(&pool), buffer_(std::move(buffer)) {
+    }
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease(Lease&& other) noexcept : pool_(std::exchange(other.pool_, nullptr)), buffer_(std::move(other.buffer_)) {
+    }
+    Lease& operator=(Lease&&) = delete;
+    ~Lease() {
+      if (pool_) {
+        pool_->Release(std::move(buffer_));
+      }
+    }
+
+    Buffer& Get() {
+      return buffer_;
+    }
+
+  private:
+    SendBufferPool* pool_;
+    Buffer buffer_;
+  };
+
+  SendBufferPool();
+
+  /**
+   * @brief Gets the pool of the calling thread
+   */
+  static SendBufferPool& ForCurrentThread();
+
+  /**
+   * @brief Borrows a buffer of at least min_size bytes, preferring the smallest free one that fits
+   * @param min_size Expected serialized size, 0 if unknown
+   */
+  Lease Acquire(std::size_t min_size = 0);
+
+  /**
+   * @brief Number of buffers allocated because no free one was available
+   */
+  std::uint64_t GetAllocationCount() const {
+    return allocations_;
+  }
+
+  /**
+   * @brief Serializes a packet into a pooled buffer
+   * @return The lease holding the buffer and the number of bytes written
+   */
+  template <typename Packet>
+  std::pair<Lease, std::size_t> Serialize(const Packet& packet, std::size_t min_size = 0) {
+    Lease lease = Acquire(min_size);
+    const std::size_t written_size = bitsery::quickSerialization<OutputAdapter>(lease.Get(), packet);
+    return {std::move(lease), written_size};
+  }
+
+private:
+  static std::size_t GetSizeClass(std::size_t size);
+  void Release(Buffer buffer);
+
+  std::array<std::vector<Buffer>, kSizeClasses.size()> free_buffers_;
+  std::uint64_t allocations_{0};
+};
@@ -28,6 +28,7 @@ SOFTWARE.
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include <glm/glm.hpp>
 
@@ -52,9 +53,10 @@ struct OnGameTimeEvent {
   std::uint8_t min;
 };
 
+// The text points into the received packet and is only valid while the event is triggered.
 struct OnPlayerMessageEvent {
   std::uint64_t pid;
-  std::string text;
+  std::string_view text;
 };
 
 struct OnPlayerCommandEvent {
@@ -62,10 +64,11 @@ struct OnPlayerCommandEvent {
   std::string command;
 };
 
+// The text points into the received packet and is only valid while the event is triggered.
 struct OnPlayerWhisperEvent {
   std::uint64_t from_id;
   std::uint64_t to_id;
-  std::string text;
+  std::string_view text;
 };
 
 struct OnPlayerKillEvent {
@@ -109,4 +112,6 @@ struct OnPlayerHitEvent {
   std::optional<std::uint64_t> attacker_id;
   std::uint64_t victim_id;
   std::int16_t damage;
+  // Set when the server discarded the hit because the players were too far apart.
+  bool rejected{false};
 };
\ No newline at end of file
@@ -0,0 +1,308 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "snapshot_builder.h"
+
+#include <algorithm>
+
+namespace {
+
+// True if sequence a was sent after b, taking wrap-around into account.
+bool IsNewerSequence(std::uint16_t a, std::uint16_t b) {
+  return static_cast<std::int16_t>(a - b) > 0;
+}
+
+// True if the pair is due this tick. The phase is derived from both ids, so the pairs of a band are spread over the interval.
+bool IsPairDue(std::uint32_t tick, std::uint32_t interval, std::uint32_t recipient_id, std::uint32_t target_id) {
+  if (interval <= 1) {
+    return true;
+  }
+  const std::uint32_t phase = (recipient_id * 2654435761u) ^ (target_id * 40503u);
+  return (tick + phase) % interval == 0;
+}
+
+}  // namespace
+
+SnapshotBuilder::SnapshotBuilder(const PlayerManager& player_manager, const SpatialGrid& spatial_grid)
+    : player_manager_(player_manager), spatial_grid_(spatial_grid), workers_(1) {
+  SetLodSettings(LodSettings{});
+}
+
+void SnapshotBuilder::SetLodSettings(const LodSettings& settings) {
+  lod_ = settings;
+  lod_.full_interval = std::max<std::uint32_t>(lod_.full_interval, 1);
+  lod_.near_interval = std::max<std::uint32_t>(lod_.near_interval, 1);
+  lod_.far_interval = std::max<std::uint32_t>(lod_.far_interval, 1);
+  full_radius_squared_ = lod_.full_radius * lod_.full_radius;
+  near_radius_squared_ = lod_.near_radius * lod_.near_radius;
+}
+
+void SnapshotBuilder::SetWorkerCount(std::size_t count) {
+  workers_.resize(std::max<std::size_t>(count, 1));
+}
+
+SnapshotBuilder::TickStats SnapshotBuilder::GetTickStats() const {
+  TickStats total;
+  for (const WorkerState& worker : workers_) {
+    total.sent_states += worker.tick_stats.sent_states;
+    total.suppressed_states += worker.tick_stats.suppressed_states;
+    total.sent_positions += worker.tick_stats.sent_positions;
+    total.deferred_entries += worker.tick_stats.deferred_entries;
+  }
+  return total;
+}
+
+void SnapshotBuilder::SetKeepaliveInterval(std::uint32_t interval) {
+  keepalive_interval_ = std::clamp<std::uint32_t>(interval, 1, kSnapshotBaselineWindow - 1);
+}
+
+void SnapshotBuilder::BeginTick() {
+  ++tick_;
+  active_players_.clear();
+  positions_.Clear();
+  // Updated in place rather than rebuilt, so a tick with the same players as the last one does not allocate map nodes.
+  player_manager_.ForEachIngamePlayer([&](const Player& player) {
+    active_indices_[player.player_id] = active_players_.size();
+    active_players_.push_back(&player);
+    positions_.Push(player.player_id, player.state.position);
+  });
+  std::erase_if(active_indices_, [&](const auto& entry) {
+    return entry.second >= active_players_.size() || active_players_[entry.second]->player_id != entry.first;
+  });
+  // Build only looks histories up, so several threads can build at once.
+  for (const Player* player : active_players_) {
+    histories_.try_emplace(player->player_id);
+  }
+  for (WorkerState& worker : workers_) {
+    worker.near_marks.assign(active_players_.size(), 0);
+    worker.batch_indices.resize(active_players_.size());
+    worker.batch_bands.resize(active_players_.size());
+    worker.batch_distances.resize(active_players_.size());
+    worker.tick_stats = TickStats{};
+  }
+}
+
+SnapshotBuilder::TargetPriority& SnapshotBuilder::AccumulatePriority(RecipientHistory& history, PlayerId target_id, float distance_squared) {
+  TargetPriority& priority = history.priorities[target_id];
+  // 1 next to the recipient, 1/2 at the edge of the full band, falling off with the squared distance beyond it.
+  float increment = 1.0f / (1.0f + distance_squared / std::max(full_radius_squared_, 1.0f));
+  if (priority.interaction_tick != 0 && tick_ - priority.interaction_tick < kInteractionRelevanceTicks) {
+    increment *= kInteractionPriorityScale;
+  }
+  priority.accumulated += increment;
+  return priority;
+}
+
+void SnapshotBuilder::Build(std::size_t recipient_index, SnapshotPacket& packet, std::size_t byte_budget, std::size_t worker_index) {
+  WorkerState& worker = workers_[worker_index];
+  std::vector<Candidate>& candidates = worker.candidates;
+  TickStats& tick_stats = worker.tick_stats;
+
+  packet.player_states.clear();
+  packet.player_positions.clear();
+
+  const Player& recipient = *active_players_[recipient_index];
+  const std::size_t mark = recipient_index + 1;
+
+  RecipientHistory& history = histories_.find(recipient.player_id)->second;
+  packet.sequence = ++history.last_sequence;
+  SentSnapshot& sent = history.sent[packet.sequence % kSnapshotBaselineWindow];
+  sent.sequence = packet.sequence;
+  sent.acknowledged = false;
+  sent.states.clear();
+  // Sized for the worst case up front, otherwise each of the window's slots keeps growing whenever a tick sends more states than before.
+  sent.states.reserve(active_players_.size());
+  packet.player_states.reserve(active_players_.size());
+  packet.player_positions.reserve(active_players_.size());
+  candidates.clear();
+  candidates.reserve(active_players_.size());
+
+  // Nearby players get the full state. The grid only reports candidates from the surrounding cells.
+  std::size_t batch_size = 0;
+  spatial_grid_.ForEachNeighbour(recipient.state.position, [&](PlayerId candidate_id) {
+    auto index_it = active_indices_.find(candidate_id);
+    if (index_it != active_indices_.end() && index_it->second != recipient_index) {
+      worker.batch_indices[batch_size++] = static_cast<std::uint32_t>(index_it->second);
+    }
+  });
+
+  // Band 0 is the full band, 1 the near band, anything further out is left to the map-only list.
+  const float band_limits_squared[] = {full_radius_squared_, near_radius_squared_};
+  ClassifyDistances(positions_, std::span(worker.batch_indices.data(), batch_size), recipient.state.position, band_limits_squared,
+                    worker.batch_bands, worker.batch_distances, distance_kernel_);
+
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    const std::uint8_t band = worker.batch_bands[i];
+    if (band > 1) {
+      continue;
+    }
+
+    const std::size_t target_index = worker.batch_indices[i];
+    const Player& target = *active_players_[target_index];
+
+    // Keep it out of the map-only list even when it is skipped this tick.
+    worker.near_marks[target_index] = mark;
+
+    const std::uint32_t interval = band == 0 ? lod_.full_interval : lod_.near_interval;
+    if (!IsPairDue(tick_, interval, recipient.player_id, target.player_id)) {
+      continue;
+    }
+
+    // The recipient only keeps the last kSnapshotBaselineWindow states, older baselines are useless.
+    auto baseline_it = history.baselines.find(target.player_id);
+    std::uint16_t baseline_age = 0;
+    if (baseline_it != history.baselines.end()) {
+      baseline_age = packet.sequence - baseline_it->second.sequence;
+      if (baseline_age >= kSnapshotBaselineWindow) {
+        history.baselines.erase(baseline_it);
+        baseline_it = history.baselines.end();
+        baseline_age = 0;
+      }
+    }
+
+    // Nothing changed since the acknowledged state, so only send a keepalive once in a while.
+    if (baseline_it != history.baselines.end() && baseline_it->second.revision == target.state_revision &&
+        baseline_age < keepalive_interval_) {
+      ++tick_stats.suppressed_states;
+      continue;
+    }
+
+    Candidate candidate{target_index, &AccumulatePriority(history, target.player_id, worker.batch_distances[i]), 0, true, 0, kAllPlayerStateFields};
+    if (delta_compression_ && baseline_it != history.baselines.end()) {
+      PlayerState state = target.state;
+      state.health_points = target.health;
+      candidate.baseline_age = static_cast<std::uint8_t>(baseline_age);
+      candidate.changed_fields = GetChangedPlayerStateFields(baseline_it->second.state, state);
+    }
+    candidate.size = GetSnapshotPlayerStateSize(candidate.baseline_age, candidate.changed_fields);
+    candidates.push_back(candidate);
+  }
+
+  // Everyone else is only shown on the map.
+  batch_size = 0;
+  for (std::size_t target_index = 0; target_index < active_players_.size(); ++target_index) {
+    if (target_index == recipient_index || worker.near_marks[target_index] == mark) {
+      continue;
+    }
+    if (IsPairDue(tick_, lod_.far_interval, recipient.player_id, active_players_[target_index]->player_id)) {
+      worker.batch_indices[batch_size++] = static_cast<std::uint32_t>(target_index);
+    }
+  }
+
+  // Only the distances are needed, for the priorities.
+  ClassifyDistances(positions_, std::span(worker.batch_indices.data(), batch_size), recipient.state.position, {}, worker.batch_bands,
+                    worker.batch_distances, distance_kernel_);
+
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    const std::size_t target_index = worker.batch_indices[i];
+    TargetPriority& priority = AccumulatePriority(history, active_players_[target_index]->player_id, worker.batch_distances[i]);
+    candidates.push_back(Candidate{target_index, &priority, kSnapshotPlayerPositionSize, false, 0, 0});
+  }
+
+  // Usually everything fits and the order doesn't matter. Otherwise the most starved and most relevant entries go first.
+  std::size_t total_size = 0;
+  for (const Candidate& candidate : candidates) {
+    total_size += candidate.size;
+  }
+  if (total_size > byte_budget) {
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.priority->accumulated > b.priority->accumulated; });
+  }
+
+  std::size_t spent = 0;
+  for (const Candidate& candidate : candidates) {
+    // Smaller entries further down may still fit.
+    if (candidate.size > byte_budget - spent) {
+      ++tick_stats.deferred_entries;
+      continue;
+    }
+    spent += candidate.size;
+    candidate.priority->accumulated = 0.0f;
+
+    const Player& target = *active_players_[candidate.target_index];
+    if (!candidate.with_state) {
+      SnapshotPlayerPosition& entry = packet.player_positions.emplace_back();
+      entry.player_id = target.net_id;
+      entry.position = target.state.position;
+      ++tick_stats.sent_positions;
+      continue;
+    }
+
+    SnapshotPlayerState& entry = packet.player_states.emplace_back();
+    entry.player_id = target.net_id;
+    entry.state = target.state;
+    entry.state.health_points = target.health;
+    entry.baseline_age = candidate.baseline_age;
+    entry.changed_fields = candidate.changed_fields;
+    sent.states.push_back(SentState{target.player_id, target.state_revision, entry.state});
+    ++tick_stats.sent_states;
+  }
+}
+
+void SnapshotBuilder::Acknowledge(PlayerId recipient_id, std::uint16_t sequence) {
+  auto history_it = histories_.find(recipient_id);
+  if (history_it == histories_.end()) {
+    return;
+  }
+
+  RecipientHistory& history = history_it->second;
+  SentSnapshot& sent = history.sent[sequence % kSnapshotBaselineWindow];
+  // Either already handled, or so old that its slot has been reused.
+  if (sent.acknowledged || sent.sequence != sequence) {
+    return;
+  }
+  sent.acknowledged = true;
+
+  for (const SentState& sent_state : sent.states) {
+    auto [baseline_it, inserted] = history.baselines.try_emplace(sent_state.player_id);
+    if (inserted || IsNewerSequence(sequence, baseline_it->second.sequence)) {
+      baseline_it->second.sequence = sequence;
+      baseline_it->second.revision = sent_state.revision;
+      baseline_it->second.state = sent_state.state;
+    }
+  }
+
+  // Baselines of players that went out of range would otherwise linger until the sequence wraps around.
+  std::erase_if(history.baselines, [&](const auto& baseline) {
+    return static_cast<std::uint16_t>(history.last_sequence - baseline.second.sequence) >= kSnapshotBaselineWindow;
+  });
+}
+
+void SnapshotBuilder::NoteInteraction(PlayerId first_id, PlayerId second_id) {
+  if (first_id == second_id) {
+    return;
+  }
+  // 0 means no interaction, which BeginTick has not moved past before the first tick.
+  const std::uint32_t tick = std::max<std::uint32_t>(tick_, 1);
+  histories_[first_id].priorities[second_id].interaction_tick = tick;
+  histories_[second_id].priorities[first_id].interaction_tick = tick;
+}
+
+void SnapshotBuilder::RemovePlayer(PlayerId player_id) {
+  histories_.erase(player_id);
+  for (auto& [recipient_id, history] : histories_) {
+    history.baselines.erase(player_id);
+    history.priorities.erase(player_id);
+  }
+}
@@ -0,0 +1,243 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "distance_kernel.h"
+#include "packets.h"
+#include "player_manager.h"
+#include "spatial_grid.h"
+
+/**
+ * @brief Builds the per-tick snapshot packets sent to every in-game player.
+ *
+ * Each recipient gets a single SnapshotPacket holding the full state of the players
+ * within the near LOD radius and the positions of everyone else. How often a player
+ * is included depends on the LOD band it falls into. Every recipient/target pair
+ * has its own phase, so players in a slow band are spread evenly across ticks.
+ *
+ * A state the recipient already acknowledged is not sent again until the player's
+ * state_revision changes or the keepalive interval runs out.
+ *
+ * With delta compression enabled, a nearby player's state is encoded against the last
+ * state the recipient acknowledged for that player, as long as that baseline is still
+ * inside the kSnapshotBaselineWindow. Otherwise the full state is sent.
+ *
+ * Every snapshot has a byte budget. Each recipient keeps a priority accumulator per player,
+ * which grows every tick the player is due, faster when it is close or recently fought the
+ * recipient. When the due entries don't fit, the highest priorities are sent and reset, and
+ * the rest keep accumulating until they win a later tick.
+ *
+ * Snapshots of different recipients can be built concurrently, each thread passing its own
+ * worker index. BeginTick, Acknowledge, NoteInteraction and RemovePlayer must not overlap with Build.
+ */
+class SnapshotBuilder {
+public:
+  using PlayerId = PlayerManager::PlayerId;
+  using Player = PlayerManager::Player;
+
+  static constexpr std::size_t kNoByteBudget = std::numeric_limits<std::size_t>::max();
+  // Ticks during which a hit between two players raises their priority for each other.
+  static constexpr std::uint32_t kInteractionRelevanceTicks = 50;
+  static constexpr float kInteractionPriorityScale = 4.0f;
+
+  // Distance bands deciding how often a player is included in someone else's snapshot. Intervals are in ticks.
+  struct LodSettings {
+    float full_radius = 1500.0f;
+    std::uint32_t full_interval = 1;
+    float near_radius = 5000.0f;
+    std::uint32_t near_interval = 2;
+    std::uint32_t far_interval = 10;
+  };
+
+  /**
+   * @param player_manager Source of the player states
+   * @param spatial_grid Grid used to find nearby players, its cells must not be smaller than the near radius
+   */
+  SnapshotBuilder(const PlayerManager& player_manager, const SpatialGrid& spatial_grid);
+
+  void SetLodSettings(const LodSettings& settings);
+
+  const LodSettings& GetLodSettings() const {
+    return lod_;
+  }
+
+  /**
+   * @brief Collects the in-game players for the current tick and advances the tick counter. Must be called before Build.
+   */
+  void BeginTick();
+
+  /**
+   * @brief Gets the players that should receive a snapshot in the current tick
+   * @return The in-game players collected by BeginTick
+   */
+  const std::vector<const Player*>& GetRecipients() const {
+    return active_players_;
+  }
+
+  /**
+   * @brief Sets how many threads may call Build concurrently. Must not be called during a tick.
+   */
+  void SetWorkerCount(std::size_t count);
+
+  /**
+   * @brief Overrides the distance kernel picked for the CPU, e.g. to compare it against the scalar one
+   */
+  void SetDistanceKernel(DistanceKernel kernel) {
+    distance_kernel_ = kernel;
+  }
+
+  /**
+   * @brief Fills the snapshot for a single recipient
+   * @param recipient_index Index into GetRecipients()
+   * @param packet Packet to fill, its previous entries are discarded
+   * @param byte_budget Maximum serialized size of the entries, the rest are deferred to later ticks
+   * @param worker_index Below the worker count, concurrent calls need distinct indices
+   */
+  void Build(std::size_t recipient_index, SnapshotPacket& packet, std::size_t byte_budget = kNoByteBudget, std::size_t worker_index = 0);
+
+  /**
+   * @brief Marks a snapshot as received, making its states usable as delta baselines
+   * @param recipient_id Player who acknowledged the snapshot
+   * @param sequence Sequence number of the acknowledged snapshot
+   */
+  void Acknowledge(PlayerId recipient_id, std::uint16_t sequence);
+
+  /**
+   * @brief Makes two players more relevant to each other for kInteractionRelevanceTicks, e.g. after one hit the other
+   */
+  void NoteInteraction(PlayerId first_id, PlayerId second_id);
+
+  /**
+   * @brief Drops all baselines kept for and about a player
+   * @param player_id Player that left the game
+   */
+  void RemovePlayer(PlayerId player_id);
+
+  void SetDeltaCompression(bool enabled) {
+    delta_compression_ = enabled;
+  }
+
+  /**
+   * @brief Sets how often an unchanged state is re-sent anyway
+   * @param interval Snapshots between keepalives, clamped below kSnapshotBaselineWindow so baselines never expire
+   */
+  void SetKeepaliveInterval(std::uint32_t interval);
+
+  struct TickStats {
+    std::size_t sent_states = 0;
+    std::size_t suppressed_states = 0;
+    std::size_t sent_positions = 0;
+    // Due entries that did not fit into the byte budget.
+    std::size_t deferred_entries = 0;
+  };
+
+  /**
+   * @brief Gets the entry counts of the snapshots built since the last BeginTick, summed over all workers
+   */
+  TickStats GetTickStats() const;
+
+private:
+  struct SentState {
+    PlayerId player_id;
+    std::uint32_t revision;
+    PlayerState state;
+  };
+
+  struct SentSnapshot {
+    std::uint16_t sequence{0};
+    bool acknowledged{true};
+    std::vector<SentState> states;
+  };
+
+  struct Baseline {
+    std::uint16_t sequence{0};
+    std::uint32_t revision{0};
+    PlayerState state;
+  };
+
+  struct TargetPriority {
+    float accumulated{0.0f};
+    // 0 when the players never interacted.
+    std::uint32_t interaction_tick{0};
+  };
+
+  struct RecipientHistory {
+    std::uint16_t last_sequence{0};
+    std::array<SentSnapshot, kSnapshotBaselineWindow> sent;
+    std::unordered_map<PlayerId, Baseline> baselines;
+    std::unordered_map<PlayerId, TargetPriority> priorities;
+  };
+
+  // An entry that is due this tick, before the byte budget decides whether it is sent.
+  struct Candidate {
+    std::size_t target_index;
+    // Points into RecipientHistory::priorities, whose elements don't move when the map grows.
+    TargetPriority* priority;
+    std::size_t size;
+    bool with_state;
+    std::uint8_t baseline_age;
+    std::uint16_t changed_fields;
+  };
+
+  // Scratch space and counters of one thread calling Build.
+  struct WorkerState {
+    // Marks which players were already added with their full state for the current recipient.
+    std::vector<std::size_t> near_marks;
+    std::vector<Candidate> candidates;
+    // Batch handed to ClassifyDistances, indices into active_players_.
+    std::vector<std::uint32_t> batch_indices;
+    std::vector<std::uint8_t> batch_bands;
+    std::vector<float> batch_distances;
+    TickStats tick_stats;
+  };
+
+  // Adds this tick's priority for a due target and returns its accumulator.
+  TargetPriority& AccumulatePriority(RecipientHistory& history, PlayerId target_id, float distance_squared);
+
+  const PlayerManager& player_manager_;
+  const SpatialGrid& spatial_grid_;
+  LodSettings lod_;
+  float full_radius_squared_;
+  float near_radius_squared_;
+  std::uint32_t tick_{0};
+  std::uint32_t keepalive_interval_{10};
+  bool delta_compression_{true};
+
+  std::vector<const Player*> active_players_;
+  std::unordered_map<PlayerId, std::size_t> active_indices_;
+  // Positions of active_players_ in the same order, so distances can be computed in batches.
+  PositionArrays positions_;
+  DistanceKernel distance_kernel_{GetBestDistanceKernel()};
+  std::vector<WorkerState> workers_;
+  std::unordered_map<PlayerId, RecipientHistory> histories_;
+};
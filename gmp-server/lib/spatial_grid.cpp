@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Each axis gets 21 bits of the packed cell key, which covers over a million cells per axis.
+constexpr std::uint32_t kAxisBits = 21;
+constexpr std::int32_t kAxisBias = 1 << (kAxisBits - 1);
+constexpr std::uint64_t kAxisMask = (std::uint64_t{1} << kAxisBits) - 1;
+}  // namespace
+
+SpatialGrid::SpatialGrid(float cell_size) : cell_size_(cell_size), inverse_cell_size_(1.0f / cell_size) {
+}
+
+void SpatialGrid::Update(PlayerId player_id, const glm::vec3& position) {
+  const CellKey new_key = PackCellKey(ToCellCoords(position));
+
+  auto it = player_cells_.find(player_id);
+  if (it != player_cells_.end()) {
+    if (it->second == new_key) {
+      return;
+    }
+
+    RemoveFromCell(it->second, player_id);
+    it->second = new_key;
+  } else {
+    player_cells_.emplace(player_id, new_key);
+  }
+
+  cells_[new_key].push_back(player_id);
+}
+
+bool SpatialGrid::Remove(PlayerId player_id) {
+  auto it = player_cells_.find(player_id);
+  if (it == player_cells_.end()) {
+    return false;
+  }
+
+  RemoveFromCell(it->second, player_id);
+  player_cells_.erase(it);
+  return true;
+}
+
+void SpatialGrid::Clear() {
+  cells_.clear();
+  player_cells_.clear();
+}
+
+void SpatialGrid::RemoveFromCell(CellKey key, PlayerId player_id) {
+  auto cell_it = cells_.find(key);
+  if (cell_it == cells_.end()) {
+    return;
+  }
+  auto& cell = cell_it->second;
+  auto player_it = std::find(cell.begin(), cell.end(), player_id);
+  if (player_it != cell.end()) {
+    *player_it = cell.back();
+    cell.pop_back();
+  }
+  // Empty cells are dropped, so the map only holds occupied cells instead of every cell anyone ever visited.
+  if (cell.empty()) {
+    cells_.erase(cell_it);
+  }
+}
+
+SpatialGrid::CellCoords SpatialGrid::ToCellCoords(const glm::vec3& position) const {
+  return CellCoords{static_cast<std::int32_t>(std::floor(position.x * inverse_cell_size_)),
+                    static_cast<std::int32_t>(std::floor(position.y * inverse_cell_size_)),
+                    static_cast<std::int32_t>(std::floor(position.z * inverse_cell_size_))};
+}
+
+SpatialGrid::CellKey SpatialGrid::PackCellKey(const CellCoords& coords) {
+  const auto pack_axis = [](std::int32_t value) { return static_cast<std::uint64_t>(value + kAxisBias) & kAxisMask; };
+  return (pack_axis(coords.x) << (2 * kAxisBits)) | (pack_axis(coords.y) << kAxisBits) | pack_axis(coords.z);
+}
@@ -0,0 +1,136 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Uniform spatial hash grid used for interest management.
+ *
+ * Players are bucketed into cubic cells of a fixed size. A neighbour query only visits
+ * the 3x3x3 block of cells around the queried position, so as long as the query radius
+ * does not exceed the cell size every player within that radius is reported.
+ */
+class SpatialGrid {
+public:
+  using PlayerId = std::uint32_t;
+
+  /**
+   * @brief Creates an empty grid
+   * @param cell_size Edge length of a single cell, in world units
+   */
+  explicit SpatialGrid(float cell_size);
+
+  /**
+   * @brief Inserts a player or moves it to the cell matching its new position
+   * @param player_id The player ID
+   * @param position The player's current position
+   */
+  void Update(PlayerId player_id, const glm::vec3& position);
+
+  /**
+   * @brief Removes a player from the grid
+   * @param player_id The player ID
+   * @return true if the player was found and removed, false otherwise
+   */
+  bool Remove(PlayerId player_id);
+
+  /**
+   * @brief Removes all players from the grid
+   */
+  void Clear();
+
+  /**
+   * @brief Iterates over all players in the 3x3x3 cells surrounding a position
+   *
+   * Candidates are not filtered by distance, callers are expected to run their own
+   * radius check on the reported players.
+   *
+   * @param position The query position
+   * @param func Function to call for each candidate (receives PlayerId)
+   */
+  template <typename Func>
+  void ForEachNeighbour(const glm::vec3& position, Func&& func) const {
+    const CellCoords center = ToCellCoords(position);
+    for (std::int32_t dx = -1; dx <= 1; ++dx) {
+      for (std::int32_t dy = -1; dy <= 1; ++dy) {
+        for (std::int32_t dz = -1; dz <= 1; ++dz) {
+          auto it = cells_.find(PackCellKey({center.x + dx, center.y + dy, center.z + dz}));
+          if (it == cells_.end()) {
+            continue;
+          }
+          for (PlayerId player_id : it->second) {
+            func(player_id);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the number of players stored in the grid
+   * @return The player count
+   */
+  std::size_t GetPlayerCount() const {
+    return player_cells_.size();
+  }
+
+  /**
+   * @brief Gets the number of cells holding at least one player
+   * @return The occupied cell count
+   */
+  std::size_t GetCellCount() const {
+    return cells_.size();
+  }
+
+  /**
+   * @brief Gets the edge length of a single cell
+   * @return The cell size in world units
+   */
+  float GetCellSize() const {
+    return cell_size_;
+  }
+
+private:
+  using CellKey = std::uint64_t;
+
+  struct CellCoords {
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t z;
+  };
+
+  void RemoveFromCell(CellKey key, PlayerId player_id);
+  CellCoords ToCellCoords(const glm::vec3& position) const;
+  static CellKey PackCellKey(const CellCoords& coords);
+
+  float cell_size_;
+  float inverse_cell_size_;
+  std::unordered_map<CellKey, std::vector<PlayerId>> cells_;
+  std::unordered_map<PlayerId, CellKey> player_cells_;
+};
@@ -0,0 +1,97 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "spawn_record_cache.h"
+
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/bitsery.h>
+#include <bitsery/traits/vector.h>
+
+#include <cstring>
+
+#include "packets.h"
+
+namespace {
+
+using OutputAdapter = bitsery::OutputBufferAdapter<std::vector<std::uint8_t>>;
+
+// ExistingPlayerInfo starts with the NetId and the selected class, followed by the position.
+constexpr std::size_t kPositionOffset = sizeof(NetId) + sizeof(std::uint8_t);
+constexpr std::size_t kPositionSize = GetPlayerStateFieldsSize(PSF_POSITION);
+
+struct PositionField {
+  glm::vec3 position;
+};
+
+template <typename S>
+void serialize(S& s, PositionField& field) {
+  s.enableBitPacking([&field](typename S::BPEnabledType& sbp) { sbp.ext(field.position, Net::QuantizedPosition{}); });
+}
+
+}  // namespace
+
+std::span<const std::uint8_t> SpawnRecordCache::Get(const Player& player, const PlayerInfo& info) {
+  Record& record = records_[player.player_id];
+  if (!record.valid) {
+    Rebuild(record, player, info);
+  } else if (record.position_revision != player.state_revision) {
+    bitsery::quickSerialization<OutputAdapter>(position_bytes_, PositionField{player.state.position});
+    std::memcpy(record.bytes.data() + kPositionOffset, position_bytes_.data(), kPositionSize);
+    record.position_revision = player.state_revision;
+  }
+  return {record.bytes.data(), record.size};
+}
+
+void SpawnRecordCache::Invalidate(PlayerId player_id) {
+  auto it = records_.find(player_id);
+  if (it != records_.end()) {
+    it->second.valid = false;
+  }
+}
+
+void SpawnRecordCache::Remove(PlayerId player_id) {
+  records_.erase(player_id);
+}
+
+void SpawnRecordCache::Clear() {
+  records_.clear();
+}
+
+void SpawnRecordCache::Rebuild(Record& record, const Player& player, const PlayerInfo& info) {
+  ExistingPlayerInfo player_packet;
+  player_packet.player_id = player.net_id;
+  player_packet.position = player.state.position;
+  player_packet.left_hand_item_instance = player.state.left_hand_item_instance;
+  player_packet.right_hand_item_instance = player.state.right_hand_item_instance;
+  player_packet.equipped_armor_instance = player.state.equipped_armor_instance;
+  player_packet.head_model = info.head;
+  player_packet.skin_texture = info.skin;
+  player_packet.face_texture = info.body;
+  player_packet.walk_style = info.walkstyle;
+  player_packet.player_name = info.name;
+  record.size = bitsery::quickSerialization<OutputAdapter>(record.bytes, player_packet);
+  record.position_revision = player.state_revision;
+  record.valid = true;
+  ++rebuilds_;
+}
@@ -0,0 +1,84 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "player_manager.h"
+
+/**
+ * @brief Keeps every player's ExistingPlayerInfo serialized, so join bursts don't rebuild them per joining client
+ *
+ * A record is rebuilt only after Invalidate, i.e. when name, appearance or equipment changed. The position
+ * changes all the time, so it is written into the cached bytes when a record is requested and the player's
+ * state_revision moved on since the last time.
+ */
+class SpawnRecordCache {
+public:
+  using Player = PlayerManager::Player;
+  using PlayerId = PlayerManager::PlayerId;
+  using PlayerInfo = PlayerManager::PlayerInfo;
+
+  /**
+   * @brief Gets the serialized ExistingPlayerInfo of a player at its current position
+   * @return Bytes valid until the next call for the same player or Remove
+   */
+  std::span<const std::uint8_t> Get(const Player& player, const PlayerInfo& info);
+
+  /**
+   * @brief Makes the next Get rebuild the record of a player
+   */
+  void Invalidate(PlayerId player_id);
+
+  void Remove(PlayerId player_id);
+  void Clear();
+
+  /**
+   * @brief Number of records serialized from scratch so far
+   */
+  std::uint64_t GetRebuildCount() const {
+    return rebuilds_;
+  }
+
+private:
+  struct Record {
+    std::vector<std::uint8_t> bytes;
+    std::size_t size{0};
+    // state_revision of the player when the position was last written.
+    std::uint32_t position_revision{0};
+    bool valid{false};
+  };
+
+  void Rebuild(Record& record, const Player& player, const PlayerInfo& info);
+
+  std::unordered_map<PlayerId, Record> records_;
+  // Serialized position, patched into the records.
+  std::vector<std::uint8_t> position_bytes_;
+  std::uint64_t rebuilds_{0};
+};
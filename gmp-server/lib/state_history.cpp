@@ -0,0 +1,113 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "state_history.h"
+
+#include <algorithm>
+#include <glm/glm.hpp>
+
+StateHistory::StateHistory(std::size_t samples_per_player) {
+  SetSamplesPerPlayer(samples_per_player);
+}
+
+void StateHistory::SetSamplesPerPlayer(std::size_t samples_per_player) {
+  Clear();
+  // Interpolation needs two states.
+  samples_per_player_ = std::max<std::size_t>(samples_per_player, 2);
+}
+
+void StateHistory::Record(PlayerId player_id, Clock::time_point time, const PlayerState& state) {
+  auto [ring_it, inserted] = rings_.try_emplace(player_id);
+  Ring& ring = ring_it->second;
+  if (inserted) {
+    if (!free_offsets_.empty()) {
+      ring.offset = free_offsets_.back();
+      free_offsets_.pop_back();
+    } else {
+      ring.offset = samples_.size();
+      samples_.resize(samples_.size() + samples_per_player_);
+    }
+  } else {
+    ring.newest = (ring.newest + 1) % samples_per_player_;
+  }
+
+  samples_[ring.offset + ring.newest] = Sample{time, state};
+  ring.count = std::min(ring.count + 1, samples_per_player_);
+}
+
+std::optional<PlayerState> StateHistory::Rewind(PlayerId player_id, Clock::time_point time) const {
+  auto ring_it = rings_.find(player_id);
+  if (ring_it == rings_.end()) {
+    return std::nullopt;
+  }
+  const Ring& ring = ring_it->second;
+
+  // Walk back from the newest state until reaching one that is not newer than the requested time.
+  const Sample* newer = &GetSample(ring, 0);
+  if (time >= newer->time) {
+    return newer->state;
+  }
+  for (std::size_t age = 1; age < ring.count; ++age) {
+    const Sample& older = GetSample(ring, age);
+    if (older.time > time) {
+      newer = &older;
+      continue;
+    }
+
+    const auto span = std::chrono::duration<float>(newer->time - older.time).count();
+    const float t = span > 0.0f ? std::chrono::duration<float>(time - older.time).count() / span : 0.0f;
+    PlayerState state = older.state;
+    state.position = glm::mix(older.state.position, newer->state.position, t);
+    state.nrot = glm::mix(older.state.nrot, newer->state.nrot, t);
+    return state;
+  }
+  return newer->state;
+}
+
+StateHistory::Clock::time_point StateHistory::GetViewTime(Clock::time_point now, std::chrono::milliseconds round_trip,
+                                                          std::chrono::milliseconds tick_interval, std::chrono::milliseconds max_rewind) {
+  return now - std::min(std::max(round_trip, std::chrono::milliseconds(0)) + tick_interval, max_rewind);
+}
+
+bool StateHistory::IsHitInRange(const PlayerState& attacker_state, PlayerId victim_id, const PlayerState& victim_state, Clock::time_point view_time,
+                                float max_distance) const {
+  const glm::vec3 victim_position = Rewind(victim_id, view_time).value_or(victim_state).position;
+  const glm::vec3 offset = victim_position - attacker_state.position;
+  return glm::dot(offset, offset) <= max_distance * max_distance;
+}
+
+void StateHistory::Remove(PlayerId player_id) {
+  auto ring_it = rings_.find(player_id);
+  if (ring_it == rings_.end()) {
+    return;
+  }
+  free_offsets_.push_back(ring_it->second.offset);
+  rings_.erase(ring_it);
+}
+
+void StateHistory::Clear() {
+  samples_.clear();
+  rings_.clear();
+  free_offsets_.clear();
+}
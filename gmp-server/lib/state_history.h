@@ -0,0 +1,129 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "common_structs.h"
+
+/**
+ * @brief Keeps the recent states of every player, so the server can look at the world as a client saw it
+ *
+ * Each player gets a fixed-size ring of timestamped states. All rings live back to back in a single
+ * array and the ring of a player that left is reused by the next one, so recording never allocates
+ * once the server has seen its peak player count.
+ */
+class StateHistory {
+public:
+  using PlayerId = std::uint32_t;
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @param samples_per_player How many states are kept per player, at least 2
+   */
+  explicit StateHistory(std::size_t samples_per_player);
+
+  /**
+   * @brief Changes the ring size, dropping everything recorded so far
+   */
+  void SetSamplesPerPlayer(std::size_t samples_per_player);
+
+  std::size_t GetSamplesPerPlayer() const {
+    return samples_per_player_;
+  }
+
+  /**
+   * @brief Appends a state, overwriting the player's oldest one when the ring is full
+   * @param time Must not be older than the previously recorded state of the player
+   */
+  void Record(PlayerId player_id, Clock::time_point time, const PlayerState& state);
+
+  /**
+   * @brief Gets the state of a player at a point in time
+   *
+   * Position and rotation are interpolated between the states recorded around the time, the other
+   * fields are taken from the older one. Times outside the recorded range are clamped to it.
+   *
+   * @return std::nullopt if nothing was recorded for the player
+   */
+  std::optional<PlayerState> Rewind(PlayerId player_id, Clock::time_point time) const;
+
+  /**
+   * @brief Gets the time of the world an attacker was looking at when sending a hit that arrives now
+   *
+   * The snapshot the attacker saw was half a round trip old when it arrived, and the hit took another half
+   * round trip to come back. The snapshot itself may have been built up to a tick after the state it shows.
+   *
+   * @param max_rewind Limit of the rewind, see lag_compensation_ms
+   */
+  static Clock::time_point GetViewTime(Clock::time_point now, std::chrono::milliseconds round_trip, std::chrono::milliseconds tick_interval,
+                                       std::chrono::milliseconds max_rewind);
+
+  /**
+   * @brief Checks whether a victim was within reach of an attacker as the attacker saw it
+   *
+   * Only the victim is rewound. The attacker's own updates reach the server with the same delay as the hit,
+   * so its newest state already is where it stood when hitting.
+   *
+   * @param attacker_state The attacker's current state
+   * @param victim_state Used when nothing was recorded for the victim
+   * @param view_time See GetViewTime
+   */
+  bool IsHitInRange(const PlayerState& attacker_state, PlayerId victim_id, const PlayerState& victim_state, Clock::time_point view_time,
+                    float max_distance) const;
+
+  void Remove(PlayerId player_id);
+  void Clear();
+
+private:
+  struct Sample {
+    Clock::time_point time;
+    PlayerState state;
+  };
+
+  struct Ring {
+    // Index of the ring's first sample in samples_.
+    std::size_t offset;
+    // Position of the newest sample within the ring.
+    std::size_t newest{0};
+    std::size_t count{0};
+  };
+
+  // The i-th newest sample of a ring, 0 being the newest.
+  const Sample& GetSample(const Ring& ring, std::size_t age) const {
+    return samples_[ring.offset + (ring.newest + samples_per_player_ - age) % samples_per_player_];
+  }
+
+  std::size_t samples_per_player_;
+  std::vector<Sample> samples_;
+  std::unordered_map<PlayerId, Ring> rings_;
+  // Offsets of rings released by Remove.
+  std::vector<std::size_t> free_offsets_;
+};
@@ -0,0 +1,107 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "tick_scheduler.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace {
+// Limits overrun and skip warnings under sustained load, the count since the last warning is included instead.
+constexpr std::chrono::seconds kLoadWarningInterval{5};
+}  // namespace
+
+TickScheduler::TickScheduler(const Settings& settings, TimeSource time_source) : settings_(settings), time_source_(std::move(time_source)) {
+  if (!time_source_.now) {
+    time_source_.now = [] { return Clock::now(); };
+  }
+  if (!time_source_.sleep_until) {
+    time_source_.sleep_until = [](Clock::time_point time) { std::this_thread::sleep_until(time); };
+  }
+  settings_.tick_interval = std::max(settings_.tick_interval, std::chrono::milliseconds(1));
+  settings_.poll_interval = std::clamp(settings_.poll_interval, std::chrono::milliseconds(1), settings_.tick_interval);
+}
+
+void TickScheduler::Run(const std::atomic<bool>& running, const std::function<void()>& poll, const std::function<void()>& tick) {
+  Clock::time_point next_tick = time_source_.now() + settings_.tick_interval;
+
+  while (running.load(std::memory_order_acquire)) {
+    poll();
+
+    const Clock::time_point now = time_source_.now();
+    if (now < next_tick) {
+      time_source_.sleep_until(std::min(next_tick, now + settings_.poll_interval));
+      continue;
+    }
+
+    // Ticks that are overdue beyond the catch-up limit are dropped, keeping the schedule on the original grid.
+    const auto overdue_ticks = static_cast<std::uint64_t>((now - next_tick) / settings_.tick_interval);
+    if (overdue_ticks > settings_.max_catch_up_ticks) {
+      const std::uint64_t skipped = overdue_ticks - settings_.max_catch_up_ticks;
+      next_tick += settings_.tick_interval * skipped;
+      stats_.skipped_ticks.fetch_add(skipped, std::memory_order_relaxed);
+      skipped_since_log_ += skipped;
+      if (now - last_skip_log_ >= kLoadWarningInterval) {
+        SPDLOG_WARN("Server is {} ticks behind, skipping {} of them ({} ticks skipped in the last {}s)", overdue_ticks, skipped,
+                    skipped_since_log_, kLoadWarningInterval.count());
+        last_skip_log_ = now;
+        skipped_since_log_ = 0;
+      }
+    }
+
+    RunTick(tick);
+    next_tick += settings_.tick_interval;
+  }
+}
+
+void TickScheduler::RunTick(const std::function<void()>& tick) {
+  const Clock::time_point start = time_source_.now();
+  tick();
+  const Clock::time_point end = time_source_.now();
+
+  const auto duration_us = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+  stats_.ticks.fetch_add(1, std::memory_order_relaxed);
+  stats_.total_tick_us.fetch_add(duration_us, std::memory_order_relaxed);
+  stats_.last_tick_us.store(duration_us, std::memory_order_relaxed);
+  if (duration_us > stats_.max_tick_us.load(std::memory_order_relaxed)) {
+    stats_.max_tick_us.store(duration_us, std::memory_order_relaxed);
+  }
+
+  const auto budget_us = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(settings_.tick_interval).count());
+  if (duration_us <= budget_us) {
+    return;
+  }
+
+  stats_.overruns.fetch_add(1, std::memory_order_relaxed);
+  ++overruns_since_log_;
+  if (end - last_overrun_log_ >= kLoadWarningInterval) {
+    SPDLOG_WARN("Tick took {:.2f} ms, over the {} ms budget ({} overruns in the last {}s)", duration_us / 1000.0, budget_us / 1000,
+                overruns_since_log_, kLoadWarningInterval.count());
+    last_overrun_log_ = end;
+    overruns_since_log_ = 0;
+  }
+}
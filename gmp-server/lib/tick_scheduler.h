@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief Fixed timestep loop driving the server's main thread.
+ *
+ * Simulation ticks are scheduled on absolute deadlines (start + n * tick_interval),
+ * so the tick rate does not drift with load. Between ticks the network is polled
+ * every poll_interval, which keeps inbound latency independent of the tick rate.
+ *
+ * When the loop falls behind, at most max_catch_up_ticks overdue ticks are run back
+ * to back, the rest are dropped and the schedule is realigned. Ticks that take longer
+ * than tick_interval count as budget overruns.
+ *
+ * Time is read and waited for through a TimeSource, which tests replace with a manual clock.
+ */
+class TickScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Settings {
+    std::chrono::milliseconds tick_interval{100};
+    std::chrono::milliseconds poll_interval{2};
+    std::uint32_t max_catch_up_ticks{3};
+  };
+
+  // Counters are atomics, so they can be read while the loop runs on another thread.
+  struct Stats {
+    std::atomic<std::uint64_t> ticks{0};
+    std::atomic<std::uint64_t> overruns{0};
+    std::atomic<std::uint64_t> skipped_ticks{0};
+    std::atomic<std::uint64_t> total_tick_us{0};
+    std::atomic<std::uint64_t> max_tick_us{0};
+    std::atomic<std::uint64_t> last_tick_us{0};
+  };
+
+  // Empty functions fall back to the steady clock and std::this_thread::sleep_until.
+  struct TimeSource {
+    std::function<Clock::time_point()> now;
+    std::function<void(Clock::time_point)> sleep_until;
+  };
+
+  explicit TickScheduler(const Settings& settings, TimeSource time_source = {});
+
+  /**
+   * @brief Runs the loop until `running` becomes false
+   * @param running Checked before every poll
+   * @param poll Called every poll_interval and before every tick
+   * @param tick Called once per simulation tick
+   */
+  void Run(const std::atomic<bool>& running, const std::function<void()>& poll, const std::function<void()>& tick);
+
+  const Settings& GetSettings() const {
+    return settings_;
+  }
+
+  const Stats& GetStats() const {
+    return stats_;
+  }
+
+  /**
+   * @brief Resets the maximum tick duration, e.g. after it has been reported
+   */
+  void ResetMaxTickDuration() {
+    stats_.max_tick_us.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  void RunTick(const std::function<void()>& tick);
+
+  Settings settings_;
+  TimeSource time_source_;
+  Stats stats_;
+  Clock::time_point last_overrun_log_{};
+  std::uint64_t overruns_since_log_{0};
+  Clock::time_point last_skip_log_{};
+  std::uint64_t skipped_since_log_{0};
+};
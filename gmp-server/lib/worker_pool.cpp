@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "worker_pool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(std::size_t thread_count) {
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads_.reserve(thread_count - 1);
+  for (std::size_t worker_index = 1; worker_index < thread_count; ++worker_index) {
+    threads_.emplace_back(&WorkerPool::WorkerLoop, this, worker_index);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::Run(std::size_t count, std::size_t chunk_size, ChunkFunction function, void* context) {
+  chunk_size = std::max<std::size_t>(chunk_size, 1);
+  // Waking the workers costs more than a single chunk of work.
+  if (threads_.empty() || count <= chunk_size) {
+    if (count > 0) {
+      function(context, 0, count, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    function_ = function;
+    context_ = context;
+    count_ = count;
+    chunk_size_ = chunk_size;
+    next_index_.store(0, std::memory_order_relaxed);
+    busy_workers_ = threads_.size();
+    ++generation_;
+  }
+  work_available_.notify_all();
+
+  RunChunks(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this]() { return busy_workers_ == 0; });
+  function_ = nullptr;
+  context_ = nullptr;
+}
+
+void WorkerPool::WorkerLoop(std::size_t worker_index) {
+  std::uint64_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(lock, [&]() { return stopping_ || generation_ != seen_generation; });
+      if (stopping_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+
+    RunChunks(worker_index);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--busy_workers_ == 0) {
+      work_done_.notify_one();
+    }
+  }
+}
+
+void WorkerPool::RunChunks(std::size_t worker_index) {
+  while (true) {
+    const std::size_t begin = next_index_.fetch_add(chunk_size_, std::memory_order_relaxed);
+    if (begin >= count_) {
+      return;
+    }
+    function_(context_, begin, std::min(begin + chunk_size_, count_), worker_index);
+  }
+}
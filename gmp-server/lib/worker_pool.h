@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Fixed set of threads splitting index ranges between them.
+ *
+ * ParallelFor hands out chunks of the range through a shared counter, so threads that
+ * finish early take over the remaining chunks. The calling thread works along as worker 0
+ * and the call returns once every chunk is done. Only one ParallelFor may run at a time.
+ */
+class WorkerPool {
+public:
+  /**
+   * @param thread_count Number of threads working on a range, including the caller. 0 uses one per hardware thread.
+   */
+  explicit WorkerPool(std::size_t thread_count);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  std::size_t GetThreadCount() const {
+    return threads_.size() + 1;
+  }
+
+  /**
+   * @brief Calls func(begin, end, worker_index) for consecutive chunks covering [0, count)
+   * @param chunk_size Indices per chunk, smaller chunks balance uneven work better
+   * @param func Must be safe to call concurrently. worker_index is below GetThreadCount().
+   */
+  template <typename Func>
+  void ParallelFor(std::size_t count, std::size_t chunk_size, Func&& func) {
+    using FuncType = std::remove_reference_t<Func>;
+    Run(
+        count, chunk_size,
+        [](void* context, std::size_t begin, std::size_t end, std::size_t worker_index) {
+          (*static_cast<FuncType*>(context))(begin, end, worker_index);
+        },
+        const_cast<void*>(static_cast<const void*>(&func)));
+  }
+
+private:
+  // Plain function pointer and context instead of std::function, so starting a job never allocates.
+  using ChunkFunction = void (*)(void* context, std::size_t begin, std::size_t end, std::size_t worker_index);
+
+  void Run(std::size_t count, std::size_t chunk_size, ChunkFunction function, void* context);
+  void WorkerLoop(std::size_t worker_index);
+  void RunChunks(std::size_t worker_index);
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable work_done_;
+  std::uint64_t generation_{0};
+  std::size_t busy_workers_{0};
+  bool stopping_{false};
+
+  // The current job, written under the mutex before generation_ changes.
+  ChunkFunction function_{nullptr};
+  void* context_{nullptr};
+  std::size_t count_{0};
+  std::size_t chunk_size_{1};
+  std::atomic<std::size_t> next_index_{0};
+};
@@ -26,46 +26,79 @@ SOFTWARE.
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string>
 
+#include "latency_histogram.h"
 #include "net_enums.h"
 
 namespace Net {
 
 using ConnectionHandle = std::uint64_t;
 
+// Send side statistics of a single connection, as measured by the network library.
+struct ConnectionStats {
+  // Bytes put on the wire during the last second, including headers and resends.
+  std::uint64_t bytes_sent_per_second{0};
+  // Bytes queued for sending but not sent yet.
+  std::uint64_t bytes_queued{0};
+  // Set when congestion control is what limits sending, to congestion_limit_bytes_per_second.
+  bool congestion_limited{false};
+  std::uint64_t congestion_limit_bytes_per_second{0};
+};
+
 class PacketHandler {
 public:
   virtual ~PacketHandler() = default;
   virtual bool HandlePacket(ConnectionHandle connectionHandle, unsigned char* data, std::uint32_t size) = 0;
 };
 
+/**
+ * @brief Server side of the network library.
+ *
+ * Send, Broadcast, GetConnectionStats and GetAveragePing may be called from several threads at once, e.g. by
+ * snapshot workers, as long as Pulse is not running at the same time. Everything else, Pulse included, is
+ * called from the simulation thread only.
+ */
 class NetServer {
 public:
   virtual ~NetServer() = default;
 
-  // Needs to be called periodically in order to retrieve packets.
+  // Needs to be called periodically in order to retrieve packets. Handlers are invoked on the calling thread.
   virtual void Pulse() = 0;
 
   virtual bool Start(std::uint32_t port, std::uint32_t slots) = 0;
 
+  // `channel` is the ordering channel, below 32. Ordered packets only wait for earlier packets on the same channel.
   virtual bool Send(unsigned char* data, std::uint32_t size, PacketPriority packetPriority,
                     PacketReliability packetReliability, std::uint32_t channel, ConnectionHandle id) = 0;
 
   virtual bool Send(const char* data, std::uint32_t size, PacketPriority packetPriority,
                     PacketReliability packetReliability, std::uint32_t channel, ConnectionHandle id) = 0;
 
+  // Sends one already serialized payload to every connection in `recipients`. Callers serialize once
+  // instead of once per recipient; the buffer only has to stay valid for the duration of the call.
+  virtual bool Broadcast(const unsigned char* data, std::uint32_t size, PacketPriority packetPriority, PacketReliability packetReliability,
+                         std::uint32_t channel, std::span<const ConnectionHandle> recipients) = 0;
+
   virtual void AddToBanList(const char* IP, std::uint32_t milliseconds) = 0;
   virtual void AddToBanList(ConnectionHandle id, std::uint32_t milliseconds) = 0;
   virtual void RemoveFromBanList(const char* IP) = 0;
   virtual bool IsBanned(const char* IP) = 0;
 
   virtual const char* GetPlayerIp(ConnectionHandle id) = 0;
+  // Returns false if the connection is unknown.
+  virtual bool GetConnectionStats(ConnectionHandle id, ConnectionStats& stats) = 0;
+  // Average round-trip time in milliseconds, -1 if the connection is unknown.
+  virtual int GetAveragePing(ConnectionHandle id) = 0;
 
   virtual void AddPacketHandler(PacketHandler& packetHandler) = 0;
   virtual void RemovePacketHandler(PacketHandler& packetHandler) = 0;
   virtual std::uint32_t GetPort() const = 0;
   virtual std::string GetAddress() const = 0;
+
+  // Time from a packet being received until its handlers run in Pulse.
+  virtual const LatencyHistogram& GetReceiveLatency() const = 0;
 };
 
 }  // namespace Net
\ No newline at end of file
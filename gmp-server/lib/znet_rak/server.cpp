@@ -25,6 +25,8 @@ SOFTWARE.
 
 #include "server.h"
 
+#include <MessageIdentifiers.h>
+#include <RakNetStatistics.h>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
@@ -32,6 +34,8 @@ SOFTWARE.
 #include <string_view>
 
 constexpr std::string_view kServerPassword = "YOUR_PASS";
+constexpr std::chrono::milliseconds kNetworkThreadIdleSleep{1};
+constexpr std::chrono::seconds kLatencyLogInterval{60};
 
 namespace Net {
 
@@ -63,6 +67,7 @@ namespace {
 }  // namespace
 
 RakNetServer::~RakNetServer() {
+  StopNetworkThread();
   if (peer_ != nullptr) {
     peer_->Shutdown(500);
     RakNet::RakPeerInterface::DestroyInstance(peer_);
@@ -79,26 +84,119 @@ bool RakNetServer::Start(std::uint32_t port, std::uint32_t slots) {
   peer_->SetMaximumIncomingConnections(slots);
 
   RakNet::SocketDescriptor socketDescriptor{static_cast<unsigned short>(port), nullptr};
-  return peer_->Startup(slots, &socketDescriptor, 1) == RakNet::RAKNET_STARTED;
+  if (peer_->Startup(slots, &socketDescriptor, 1) != RakNet::RAKNET_STARTED) {
+    return false;
+  }
+
+  last_latency_log_ = std::chrono::steady_clock::now();
+  network_thread_running_.store(true, std::memory_order_release);
+  network_thread_ = std::thread(&RakNetServer::NetworkThreadLoop, this);
+  return true;
+}
+
+void RakNetServer::NetworkThreadLoop() {
+  while (network_thread_running_.load(std::memory_order_acquire)) {
+    RakNet::Packet* processed = nullptr;
+    while (processed_packets_.TryPop(processed)) {
+      peer_->DeallocatePacket(processed);
+      --packets_in_flight_;
+    }
+
+    bool received_any = false;
+    while (packets_in_flight_ < kPacketQueueCapacity) {
+      RakNet::Packet* packet = peer_->Receive();
+      if (packet == nullptr) {
+        break;
+      }
+      inbound_packets_.TryPush(ReceivedPacket{packet, std::chrono::steady_clock::now()});
+      ++packets_in_flight_;
+      received_any = true;
+    }
+
+    if (!received_any) {
+      std::this_thread::sleep_for(kNetworkThreadIdleSleep);
+    }
+  }
+}
+
+void RakNetServer::StopNetworkThread() {
+  if (!network_thread_.joinable()) {
+    return;
+  }
+
+  network_thread_running_.store(false, std::memory_order_release);
+  network_thread_.join();
+
+  // Both rings are only touched by this thread from now on.
+  ReceivedPacket received;
+  while (inbound_packets_.TryPop(received)) {
+    peer_->DeallocatePacket(received.packet);
+  }
+  RakNet::Packet* processed = nullptr;
+  while (processed_packets_.TryPop(processed)) {
+    peer_->DeallocatePacket(processed);
+  }
+  packets_in_flight_ = 0;
 }
 
 void RakNetServer::Pulse() {
-  for (RakNet::Packet* packet = peer_->Receive(); packet; peer_->DeallocatePacket(packet), packet = peer_->Receive()) {
+  ReceivedPacket received;
+  while (inbound_packets_.TryPop(received)) {
+    RakNet::Packet* packet = received.packet;
+    receive_latency_.Record(std::chrono::steady_clock::now() - received.received_at);
+    const unsigned char packet_id = packet->length > 0 ? packet->data[0] : 0;
+    if (packet_id == ID_NEW_INCOMING_CONNECTION) {
+      connections_.insert_or_assign(packet->guid.g, packet->guid);
+    }
     std::for_each(packetHandlers_.begin(), packetHandlers_.end(),
                   [packet](auto& handler) { handler->HandlePacket(ConnectionHandle{packet->guid.g}, packet->data, packet->length); });
+    // Handlers may still send to or look up a disconnecting player, so it is forgotten only afterwards.
+    if (packet_id == ID_DISCONNECTION_NOTIFICATION || packet_id == ID_CONNECTION_LOST) {
+      connections_.erase(packet->guid.g);
+    }
+    processed_packets_.TryPush(packet);
   }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (now - last_latency_log_ >= kLatencyLogInterval) {
+    last_latency_log_ = now;
+    if (receive_latency_.GetCount() > 0) {
+      SPDLOG_DEBUG("Receive to handle latency since start, {} packets: p50 < {} us, p99 < {} us, max < {} us", receive_latency_.GetCount(),
+                   receive_latency_.GetPercentileUs(0.5), receive_latency_.GetPercentileUs(0.99), receive_latency_.GetPercentileUs(1.0));
+    }
+  }
+}
+
+RakNet::RakNetGUID RakNetServer::ToRakNetGuid(ConnectionHandle id) const {
+  auto it = connections_.find(id);
+  // Unknown handles still work, RakPeer just has to search all slots for them.
+  return it != connections_.end() ? it->second : RakNet::RakNetGUID(id);
 }
 
 bool RakNetServer::Send(unsigned char* data, std::uint32_t size, PacketPriority packetPriority, PacketReliability packetReliability,
                         std::uint32_t channel, ConnectionHandle id) {
-  peer_->Send(reinterpret_cast<const char*>(data), size, ToRakNetPacketPriority(packetPriority), ToRakNetPacketReliability(packetReliability), 0,
-              RakNet::RakNetGUID(id), false);
+  peer_->Send(reinterpret_cast<const char*>(data), size, ToRakNetPacketPriority(packetPriority), ToRakNetPacketReliability(packetReliability),
+              static_cast<char>(channel), ToRakNetGuid(id), false);
   return true;
 }
 bool RakNetServer::Send(const char* data, std::uint32_t size, PacketPriority packetPriority, PacketReliability packetReliability,
                         std::uint32_t channel, ConnectionHandle id) {
-  peer_->Send(reinterpret_cast<const char*>(data), size, ToRakNetPacketPriority(packetPriority), ToRakNetPacketReliability(packetReliability), 0,
-              RakNet::RakNetGUID(id), false);
+  peer_->Send(reinterpret_cast<const char*>(data), size, ToRakNetPacketPriority(packetPriority), ToRakNetPacketReliability(packetReliability),
+              static_cast<char>(channel), ToRakNetGuid(id), false);
+  return true;
+}
+
+bool RakNetServer::Broadcast(const unsigned char* data, std::uint32_t size, PacketPriority packetPriority, PacketReliability packetReliability,
+                             std::uint32_t channel, std::span<const ConnectionHandle> recipients) {
+  // RakNet has no multicast to an arbitrary set of systems (broadcast=true can only exclude a single one),
+  // so the shared payload is handed to each connection in turn. Priority and reliability are converted once.
+  const auto priority = ToRakNetPacketPriority(packetPriority);
+  const auto reliability = ToRakNetPacketReliability(packetReliability);
+  const auto ordering_channel = static_cast<char>(channel);
+  const auto* payload = reinterpret_cast<const char*>(data);
+  for (ConnectionHandle id : recipients) {
+    peer_->Send(payload, size, priority, reliability, ordering_channel, ToRakNetGuid(id), false);
+  }
   return true;
 }
 
@@ -123,13 +221,36 @@ bool RakNetServer::IsBanned(const char* IP) {
 }
 
 const char* RakNetServer::GetPlayerIp(ConnectionHandle id) {
-  auto address = peer_->GetSystemAddressFromGuid(RakNet::RakNetGUID(id));
+  auto address = peer_->GetSystemAddressFromGuid(ToRakNetGuid(id));
   // This is safe because RakNet::SystemAddress::ToString() returns a pointer to a static buffer
   return address.ToString(false);
 }
 
+bool RakNetServer::GetConnectionStats(ConnectionHandle id, ConnectionStats& stats) {
+  // By index, GetStatistics(SystemAddress) would search all slots again. The slot may have been reused by someone else.
+  const RakNet::RakNetGUID guid = ToRakNetGuid(id);
+  const unsigned int system_index = guid.systemIndex;
+  RakNet::RakNetStatistics rak_stats;
+  if (peer_->GetGUIDFromIndex(system_index) != guid || !peer_->GetStatistics(system_index, &rak_stats)) {
+    return false;
+  }
+
+  stats.bytes_sent_per_second = rak_stats.valueOverLastSecond[RakNet::ACTUAL_BYTES_SENT];
+  stats.bytes_queued = 0;
+  for (double queued : rak_stats.bytesInSendBuffer) {
+    stats.bytes_queued += static_cast<std::uint64_t>(queued);
+  }
+  stats.congestion_limited = rak_stats.isLimitedByCongestionControl;
+  stats.congestion_limit_bytes_per_second = rak_stats.BPSLimitByCongestionControl;
+  return true;
+}
+
+int RakNetServer::GetAveragePing(ConnectionHandle id) {
+  return peer_->GetAveragePing(ToRakNetGuid(id));
+}
+
 void RakNetServer::AddToBanList(ConnectionHandle id, std::uint32_t milliseconds) {
-  auto address = peer_->GetSystemAddressFromGuid(RakNet::RakNetGUID(id));
+  auto address = peer_->GetSystemAddressFromGuid(ToRakNetGuid(id));
   if (address != RakNet::UNASSIGNED_SYSTEM_ADDRESS) {
     peer_->AddToBanList(address.ToString(false), milliseconds);
   } else {
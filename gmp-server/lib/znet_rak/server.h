@@ -26,13 +26,27 @@ SOFTWARE.
 
 #include <RakPeerInterface.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
+#include "latency_histogram.h"
+#include "spsc_ring.h"
 #include "znet_server.h"
 
 namespace Net {
 
+/**
+ * @brief NetServer implementation on top of RakNet.
+ *
+ * A dedicated network thread drains RakPeer::Receive into a bounded ring. Pulse, called on
+ * the simulation thread, dispatches the queued packets and hands them back through a second
+ * ring, and the network thread returns them to RakPeer. When the inbound ring is full the
+ * network thread stops receiving, so packets wait inside RakNet instead of being dropped.
+ */
 class RakNetServer : public NetServer {
 public:
   ~RakNetServer() override;
@@ -50,18 +64,54 @@ public:
   bool Send(const char* data, std::uint32_t size, PacketPriority packetPriority, PacketReliability packetReliability,
             std::uint32_t channel, ConnectionHandle id) override;
 
+  bool Broadcast(const unsigned char* data, std::uint32_t size, PacketPriority packetPriority, PacketReliability packetReliability,
+                 std::uint32_t channel, std::span<const ConnectionHandle> recipients) override;
+
   void AddToBanList(const char* IP, std::uint32_t milliseconds) override;
   void AddToBanList(ConnectionHandle id, std::uint32_t milliseconds) override;
   void RemoveFromBanList(const char* IP) override;
   bool IsBanned(const char* IP) override;
 
   const char* GetPlayerIp(ConnectionHandle id) override;
+  bool GetConnectionStats(ConnectionHandle id, ConnectionStats& stats) override;
+  int GetAveragePing(ConnectionHandle id) override;
   std::uint32_t GetPort() const override;
   std::string GetAddress() const override;
 
+  const LatencyHistogram& GetReceiveLatency() const override {
+    return receive_latency_;
+  }
+
 private:
+  struct ReceivedPacket {
+    RakNet::Packet* packet{nullptr};
+    std::chrono::steady_clock::time_point received_at{};
+  };
+
+  static constexpr std::size_t kPacketQueueCapacity = 4096;
+
+  void NetworkThreadLoop();
+  void StopNetworkThread();
+  // Gets the GUID of a connection including its system index, which lets RakPeer find the connection without scanning every slot.
+  RakNet::RakNetGUID ToRakNetGuid(ConnectionHandle id) const;
+
   RakNet::RakPeerInterface* peer_{nullptr};
   std::unordered_set<PacketHandler*> packetHandlers_;
+  // GUIDs as received with ID_NEW_INCOMING_CONNECTION. Only Pulse changes it, the send and statistics calls just read
+  // it, so they can run concurrently between Pulses (see NetServer).
+  std::unordered_map<ConnectionHandle, RakNet::RakNetGUID> connections_;
+
+  std::thread network_thread_;
+  std::atomic<bool> network_thread_running_{false};
+  // Network thread -> simulation thread.
+  SpscRing<ReceivedPacket, kPacketQueueCapacity> inbound_packets_;
+  // Simulation thread -> network thread, packets waiting for RakPeer::DeallocatePacket.
+  SpscRing<RakNet::Packet*, kPacketQueueCapacity> processed_packets_;
+  // Received but not yet deallocated, only touched by the network thread. Keeping it below the ring
+  // capacity guarantees that neither ring can overflow.
+  std::size_t packets_in_flight_{0};
+  LatencyHistogram receive_latency_;
+  std::chrono::steady_clock::time_point last_latency_log_{};
 };
 
 }  // namespace Net
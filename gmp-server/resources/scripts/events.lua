@@ -62,6 +62,10 @@ addEventHandler('onPlayerRespawn', function(playerId, posX, posY, posZ)
     LOG_INFO("Player {} respawned at {}", playerId, vectorToString(posX, posY, posZ))
 end)
 
-addEventHandler('onPlayerHit', function(attackerId, victimId, damage)
+addEventHandler('onPlayerHit', function(attackerId, victimId, damage, rejected)
+    if rejected then
+        LOG_WARN("Rejected hit of {} on {} for {} HP, they were too far apart", optionalIdToString(attackerId), victimId, damage)
+        return
+    end
     LOG_INFO("{} hit {} for {} HP", optionalIdToString(attackerId), victimId, damage)
 end)
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "admission_queue.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+}  // namespace
+
+TEST(AdmissionQueueTest, AdmitsOldestFirstUpToLimit) {
+  AdmissionQueue queue;
+  const auto start = AdmissionQueue::Clock::now();
+  const unsigned char first_request[] = {1, 2};
+  const unsigned char resent_request[] = {3};
+  for (Net::ConnectionHandle connection = 1; connection <= 5; ++connection) {
+    queue.Push(connection, first_request, start + connection * 10ms);
+  }
+  // A client resending its request keeps its place.
+  queue.Push(2, resent_request, start + 100ms);
+  EXPECT_TRUE(queue.Remove(4));
+  EXPECT_EQ(queue.GetPosition(5), 4u);
+
+  std::vector<std::pair<Net::ConnectionHandle, std::vector<unsigned char>>> admitted;
+  auto admit = [&](AdmissionQueue::Entry& entry) { admitted.emplace_back(entry.connection, entry.data); };
+  EXPECT_EQ(queue.Admit(2, start + 200ms, admit), 2u);
+  ASSERT_EQ(admitted.size(), 2u);
+  EXPECT_EQ(admitted[0].first, 1u);
+  EXPECT_EQ(admitted[1], (std::pair<Net::ConnectionHandle, std::vector<unsigned char>>{2, {3}}));
+  EXPECT_EQ(queue.GetSize(), 2u);
+  EXPECT_EQ(queue.GetOldestWait(start + 200ms), 170ms);
+
+  const auto& stats = queue.GetStats();
+  EXPECT_EQ(stats.admitted.load(), 2u);
+  EXPECT_EQ(stats.queued.load(), 2u);
+  EXPECT_EQ(stats.max_wait_us.load(), 190000u);
+  EXPECT_EQ(stats.total_wait_us.load(), 190000u + 180000u);
+
+  // 0 admits everyone.
+  EXPECT_EQ(queue.Admit(0, start + 300ms, admit), 2u);
+  EXPECT_EQ(queue.GetSize(), 0u);
+}
+
+TEST(AdmissionQueueTest, ReportsNewEntriesAndChangedPositions) {
+  AdmissionQueue queue;
+  const auto now = AdmissionQueue::Clock::now();
+  for (Net::ConnectionHandle connection = 1; connection <= 3; ++connection) {
+    queue.Push(connection, {}, now);
+  }
+
+  std::vector<std::pair<Net::ConnectionHandle, std::size_t>> reports;
+  auto report = [&](Net::ConnectionHandle connection, std::size_t position, std::size_t queue_size) {
+    EXPECT_EQ(queue_size, queue.GetSize());
+    reports.emplace_back(connection, position);
+  };
+  queue.ReportPositions(AdmissionQueue::ReportMode::kNewEntries, report);
+  EXPECT_EQ(reports.size(), 3u);
+
+  reports.clear();
+  queue.Admit(1, now, [](AdmissionQueue::Entry&) {});
+  queue.Push(4, {}, now);
+  queue.ReportPositions(AdmissionQueue::ReportMode::kNewEntries, report);
+  EXPECT_EQ(reports, (std::vector<std::pair<Net::ConnectionHandle, std::size_t>>{{4, 3}}));
+
+  reports.clear();
+  queue.ReportPositions(AdmissionQueue::ReportMode::kChangedPositions, report);
+  EXPECT_EQ(reports, (std::vector<std::pair<Net::ConnectionHandle, std::size_t>>{{2, 1}, {3, 2}}));
+}
@@ -45,15 +45,22 @@ public:
   MOCK_METHOD(bool, Start, (std::uint32_t, std::uint32_t), (override));
   MOCK_METHOD(bool, Send, (unsigned char*, std::uint32_t, Net::PacketPriority, Net::PacketReliability, std::uint32_t, Net::ConnectionHandle), (override));
   MOCK_METHOD(bool, Send, (const char*, std::uint32_t, Net::PacketPriority, Net::PacketReliability, std::uint32_t, Net::ConnectionHandle), (override));
+  MOCK_METHOD(bool, Broadcast,
+              (const unsigned char*, std::uint32_t, Net::PacketPriority, Net::PacketReliability, std::uint32_t,
+               std::span<const Net::ConnectionHandle>),
+              (override));
   MOCK_METHOD(void, AddToBanList, (const char*, std::uint32_t), (override));
   MOCK_METHOD(void, AddToBanList, (Net::ConnectionHandle, std::uint32_t), (override));
   MOCK_METHOD(void, RemoveFromBanList, (const char*), (override));
   MOCK_METHOD(bool, IsBanned, (const char*), (override));
   MOCK_METHOD(const char*, GetPlayerIp, (Net::ConnectionHandle), (override));
+  MOCK_METHOD(bool, GetConnectionStats, (Net::ConnectionHandle, Net::ConnectionStats&), (override));
+  MOCK_METHOD(int, GetAveragePing, (Net::ConnectionHandle), (override));
   MOCK_METHOD(void, AddPacketHandler, (Net::PacketHandler&), (override));
   MOCK_METHOD(void, RemovePacketHandler, (Net::PacketHandler&), (override));
   MOCK_METHOD(std::uint32_t, GetPort, (), (const override));
   MOCK_METHOD(std::string, GetAddress, (), (const override));
+  MOCK_METHOD(const LatencyHistogram&, GetReceiveLatency, (), (const override));
 };
 
 class BanListTest : public ::testing::Test {
@@ -0,0 +1,111 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "distance_kernel.h"
+
+namespace {
+
+constexpr DistanceKernel kKernels[] = {DistanceKernel::kScalar, DistanceKernel::kSse2, DistanceKernel::kAvx2};
+
+struct Classification {
+  std::vector<std::uint8_t> bands;
+  std::vector<float> distances_squared;
+};
+
+Classification Classify(const PositionArrays& positions, const std::vector<std::uint32_t>& indices, const glm::vec3& origin,
+                        const std::vector<float>& band_limits_squared, DistanceKernel kernel) {
+  Classification result{std::vector<std::uint8_t>(indices.size()), std::vector<float>(indices.size())};
+  ClassifyDistances(positions, indices, origin, band_limits_squared, result.bands, result.distances_squared, kernel);
+  return result;
+}
+
+}  // namespace
+
+TEST(DistanceKernelTest, BestKernelIsSupported) {
+  EXPECT_TRUE(IsDistanceKernelSupported(DistanceKernel::kScalar));
+  EXPECT_TRUE(IsDistanceKernelSupported(GetBestDistanceKernel()));
+}
+
+TEST(DistanceKernelTest, ClassifiesAgainstBands) {
+  PositionArrays positions;
+  positions.Push(1, {0.0f, 0.0f, 0.0f});
+  positions.Push(2, {10.0f, 0.0f, 0.0f});
+  positions.Push(3, {0.0f, 20.0f, 0.0f});
+  positions.Push(4, {0.0f, 0.0f, 30.0f});
+
+  const std::vector<std::uint32_t> indices = {3, 2, 1, 0};
+  // A distance exactly on a limit belongs to the outer band.
+  const std::vector<float> band_limits_squared = {100.0f, 500.0f};
+  const Classification result = Classify(positions, indices, {0.0f, 0.0f, 0.0f}, band_limits_squared, DistanceKernel::kScalar);
+
+  EXPECT_EQ(result.bands, (std::vector<std::uint8_t>{2, 1, 1, 0}));
+  EXPECT_EQ(result.distances_squared, (std::vector<float>{900.0f, 400.0f, 100.0f, 0.0f}));
+}
+
+TEST(DistanceKernelTest, VectorKernelsMatchScalar) {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> coordinate(-20000.0f, 20000.0f);
+
+  PositionArrays positions;
+  for (std::uint32_t id = 0; id < 1000; ++id) {
+    positions.Push(id, {coordinate(rng), coordinate(rng), coordinate(rng)});
+  }
+
+  const glm::vec3 origin{coordinate(rng), coordinate(rng), coordinate(rng)};
+  const std::vector<std::vector<float>> band_sets = {{}, {1500.0f * 1500.0f, 5000.0f * 5000.0f}, {1e6f, 1e7f, 1e8f, 4e8f}};
+
+  // Sizes around the vector widths exercise the scalar tail of each kernel.
+  for (std::size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 17u, 1000u}) {
+    std::vector<std::uint32_t> indices(count);
+    std::uniform_int_distribution<std::uint32_t> index(0, static_cast<std::uint32_t>(positions.Size() - 1));
+    for (std::uint32_t& i : indices) {
+      i = index(rng);
+    }
+    // Include distances exactly on a limit, where rounding differences would show.
+    if (count > 0) {
+      positions.x[indices[0]] = origin.x + 1500.0f;
+      positions.y[indices[0]] = origin.y;
+      positions.z[indices[0]] = origin.z;
+    }
+
+    for (const std::vector<float>& band_limits_squared : band_sets) {
+      const Classification expected = Classify(positions, indices, origin, band_limits_squared, DistanceKernel::kScalar);
+      for (DistanceKernel kernel : kKernels) {
+        if (!IsDistanceKernelSupported(kernel)) {
+          continue;
+        }
+        const Classification actual = Classify(positions, indices, origin, band_limits_squared, kernel);
+        EXPECT_EQ(actual.bands, expected.bands) << "kernel " << static_cast<int>(kernel) << ", count " << count;
+        EXPECT_EQ(actual.distances_squared, expected.distances_squared) << "kernel " << static_cast<int>(kernel) << ", count " << count;
+      }
+    }
+  }
+}
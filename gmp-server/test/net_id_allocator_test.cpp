@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <set>
+
+#include "net_id_allocator.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+}  // namespace
+
+TEST(NetIdAllocatorTest, QuarantinesReleasedIds) {
+  NetIdAllocator allocator(10s);
+  const auto start = NetIdAllocator::Clock::time_point{} + 1h;
+
+  const auto first = allocator.Allocate(start);
+  ASSERT_EQ(first, 1);
+  allocator.Release(*first, start);
+
+  // Still quarantined, so a new id is handed out.
+  EXPECT_EQ(allocator.Allocate(start + 5s), 2);
+  // Quarantine over, the old id is reused to keep ids small.
+  EXPECT_EQ(allocator.Allocate(start + 10s), first);
+  EXPECT_EQ(allocator.Allocate(start + 10s), 3);
+}
+
+TEST(NetIdAllocatorTest, CutsQuarantineShortWhenOutOfIds) {
+  NetIdAllocator allocator(10s);
+  const auto start = NetIdAllocator::Clock::time_point{} + 1h;
+
+  std::set<NetId> ids;
+  for (std::size_t i = 0; i < NetIdAllocator::kMaxIds; ++i) {
+    ids.insert(*allocator.Allocate(start));
+  }
+  EXPECT_EQ(ids.size(), NetIdAllocator::kMaxIds);
+  EXPECT_EQ(ids.count(0), 0u);
+  EXPECT_FALSE(allocator.Allocate(start).has_value());
+
+  allocator.Release(7, start);
+  allocator.Release(9, start + 1s);
+  EXPECT_EQ(allocator.Allocate(start + 2s), 7);
+  EXPECT_EQ(allocator.Allocate(start + 2s), 9);
+}
@@ -0,0 +1,286 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "net_enums.h"
+#include "packets.h"
+#include "quantization.h"
+
+namespace {
+
+using Buffer = std::vector<std::uint8_t>;
+using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
+using InputAdapter = bitsery::InputBufferAdapter<Buffer::const_iterator>;
+
+template <typename T>
+T RoundTrip(const T& value, std::size_t* written_size = nullptr) {
+  Buffer buffer;
+  const auto size = bitsery::quickSerialization<OutputAdapter>(buffer, value);
+  if (written_size) {
+    *written_size = size;
+  }
+
+  T result{};
+  auto state = bitsery::quickDeserialization<InputAdapter>({buffer.begin(), size}, result);
+  EXPECT_EQ(state.first, bitsery::ReaderError::NoError);
+  EXPECT_TRUE(state.second);
+  return result;
+}
+
+template <typename T>
+std::size_t SerializedSize(const T& value) {
+  Buffer buffer;
+  return bitsery::quickSerialization<OutputAdapter>(buffer, value);
+}
+
+// atan2 stays accurate for tiny angles, unlike acos of the dot product.
+float AngleBetween(const glm::vec3& a, const glm::vec3& b) {
+  const glm::vec3 cross(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+  return std::atan2(glm::length(cross), glm::dot(a, b));
+}
+
+PlayerState MakePlayerState() {
+  PlayerState state;
+  state.position = glm::vec3(-12345.6f, 789.1f, 45678.9f);
+  state.nrot = glm::normalize(glm::vec3(0.3f, -0.2f, -0.9f));
+  state.left_hand_item_instance = 101;
+  state.right_hand_item_instance = -202;
+  state.equipped_armor_instance = 303;
+  state.animation = 404;
+  state.health_points = 505;
+  state.mana_points = 606;
+  state.weapon_mode = 8;
+  state.active_spell_nr = 99;
+  state.head_direction = 4;
+  state.melee_weapon_instance = 707;
+  state.ranged_weapon_instance = 808;
+  return state;
+}
+
+// Sizes of the packets before quantization, with three raw floats per vector and a byte per small enum.
+constexpr std::size_t kLegacyPlayerStateSize = 2 * 12 + 8 * 2 + 3;
+constexpr std::size_t kLegacyPlayerStateUpdateSize = 1 + kLegacyPlayerStateSize + 1 + 4;
+constexpr std::size_t kLegacyPlayerPositionUpdateSize = 1 + 12 + 1 + 4;
+
+}  // namespace
+
+TEST(PacketQuantizationTest, PositionErrorIsWithinHalfAStep) {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> horizontal(-Net::kWorldHalfExtent, Net::kWorldHalfExtent);
+  std::uniform_real_distribution<float> vertical(-Net::kWorldHalfHeight, Net::kWorldHalfHeight);
+
+  for (int i = 0; i < 10000; ++i) {
+    PlayerPositionUpdatePacket packet{Net::PT_MAP_ONLY, glm::vec3(horizontal(rng), vertical(rng), horizontal(rng)), std::nullopt};
+    const auto result = RoundTrip(packet);
+    // The world extents are large enough for float rounding to matter at the edges.
+    const float tolerance = Net::kPositionPrecision * 0.5f + std::abs(Net::kWorldHalfExtent) * 1e-6f;
+    EXPECT_NEAR(result.position.x, packet.position.x, tolerance);
+    EXPECT_NEAR(result.position.y, packet.position.y, tolerance);
+    EXPECT_NEAR(result.position.z, packet.position.z, tolerance);
+  }
+}
+
+TEST(PacketQuantizationTest, PositionIsClampedToWorldExtents) {
+  PlayerPositionUpdatePacket packet{Net::PT_MAP_ONLY, glm::vec3(1e9f, -1e9f, NAN), 7u};
+  const auto result = RoundTrip(packet);
+
+  EXPECT_FLOAT_EQ(result.position.x, Net::kWorldHalfExtent);
+  EXPECT_FLOAT_EQ(result.position.y, -Net::kWorldHalfHeight);
+  EXPECT_FLOAT_EQ(result.position.z, -Net::kWorldHalfExtent);
+  ASSERT_TRUE(result.player_id.has_value());
+  EXPECT_EQ(*result.player_id, 7u);
+}
+
+TEST(PacketQuantizationTest, NormalAngleErrorIsSmall) {
+  std::mt19937 rng(4321);
+  std::normal_distribution<float> component(0.0f, 1.0f);
+
+  std::vector<glm::vec3> directions = {glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, -1, 0),
+                                       glm::vec3(0, 0, 1), glm::vec3(0, 0, -1), glm::vec3(1, 1, -1), glm::vec3(-1, -1, -1)};
+  for (int i = 0; i < 10000; ++i) {
+    directions.emplace_back(component(rng), component(rng), component(rng));
+  }
+
+  // Octahedral encoding keeps the error below about three quantization steps of a component.
+  const float max_angle = 6.0f / static_cast<float>(1u << Net::kNormalComponentBits);
+  for (const auto& direction : directions) {
+    const glm::vec3 decoded = Net::DecodeOctahedral(Net::EncodeOctahedral(direction));
+    EXPECT_NEAR(glm::length(decoded), 1.0f, 1e-5f);
+    EXPECT_LT(AngleBetween(decoded, direction), max_angle);
+  }
+}
+
+TEST(PacketQuantizationTest, ZeroNormalDecodesToUnitVector) {
+  const glm::vec3 decoded = Net::DecodeOctahedral(Net::EncodeOctahedral(glm::vec3(0.0f)));
+  EXPECT_NEAR(glm::length(decoded), 1.0f, 1e-5f);
+}
+
+TEST(PacketQuantizationTest, PlayerStateRoundTrip) {
+  PlayerStateUpdatePacket packet{Net::PT_ACTUAL_STATISTICS, MakePlayerState(), 42u};
+  const auto result = RoundTrip(packet);
+
+  EXPECT_NEAR(result.state.position.x, packet.state.position.x, Net::kPositionPrecision);
+  EXPECT_NEAR(result.state.position.y, packet.state.position.y, Net::kPositionPrecision);
+  EXPECT_NEAR(result.state.position.z, packet.state.position.z, Net::kPositionPrecision);
+  EXPECT_LT(AngleBetween(result.state.nrot, packet.state.nrot), 0.01f);
+  EXPECT_EQ(result.state.left_hand_item_instance, packet.state.left_hand_item_instance);
+  EXPECT_EQ(result.state.right_hand_item_instance, packet.state.right_hand_item_instance);
+  EXPECT_EQ(result.state.equipped_armor_instance, packet.state.equipped_armor_instance);
+  EXPECT_EQ(result.state.animation, packet.state.animation);
+  EXPECT_EQ(result.state.health_points, packet.state.health_points);
+  EXPECT_EQ(result.state.mana_points, packet.state.mana_points);
+  EXPECT_EQ(result.state.weapon_mode, packet.state.weapon_mode);
+  EXPECT_EQ(result.state.active_spell_nr, packet.state.active_spell_nr);
+  EXPECT_EQ(result.state.head_direction, packet.state.head_direction);
+  EXPECT_EQ(result.state.melee_weapon_instance, packet.state.melee_weapon_instance);
+  EXPECT_EQ(result.state.ranged_weapon_instance, packet.state.ranged_weapon_instance);
+  ASSERT_TRUE(result.player_id.has_value());
+  EXPECT_EQ(*result.player_id, 42u);
+}
+
+TEST(PacketQuantizationTest, SmallEnumsCoverTheirRangeAndClamp) {
+  for (std::uint32_t value = 0; value < 256; ++value) {
+    PlayerStateUpdatePacket packet{Net::PT_ACTUAL_STATISTICS, {}, std::nullopt};
+    packet.state.weapon_mode = static_cast<std::uint8_t>(value);
+    packet.state.head_direction = static_cast<std::uint8_t>(value);
+    packet.state.active_spell_nr = static_cast<std::uint8_t>(value);
+    const auto result = RoundTrip(packet);
+
+    EXPECT_EQ(result.state.weapon_mode, std::min<std::uint32_t>(value, (1u << Net::kWeaponModeBits) - 1));
+    EXPECT_EQ(result.state.head_direction, std::min<std::uint32_t>(value, (1u << Net::kHeadDirectionBits) - 1));
+    EXPECT_EQ(result.state.active_spell_nr, std::min<std::uint32_t>(value, (1u << Net::kSpellNrBits) - 1));
+  }
+}
+
+TEST(PacketQuantizationTest, JoinGameAndExistingPlayersRoundTrip) {
+  JoinGamePacket join;
+  join.packet_type = Net::PT_JOIN_GAME;
+  join.position = glm::vec3(100.5f, -20.25f, 3000.75f);
+  join.normal = glm::vec3(0.0f, 0.0f, -1.0f);
+  join.player_name = "Diego";
+  join.player_id = 5;
+  const auto join_result = RoundTrip(join);
+  EXPECT_NEAR(join_result.position.x, join.position.x, Net::kPositionPrecision);
+  EXPECT_NEAR(join_result.position.z, join.position.z, Net::kPositionPrecision);
+  EXPECT_LT(AngleBetween(join_result.normal, join.normal), 0.01f);
+  EXPECT_EQ(join_result.player_name, join.player_name);
+  EXPECT_EQ(join_result.player_id, join.player_id);
+
+  ExistingPlayersPacket existing;
+  existing.packet_type = Net::PT_EXISTING_PLAYERS;
+  existing.page = 2;
+  existing.last_page = false;
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    ExistingPlayerInfo& info = existing.existing_players.emplace_back();
+    info.player_id = i;
+    info.position = glm::vec3(i * 1000.0f, 10.0f, -(i * 1000.0f));
+    info.player_name = "Player" + std::to_string(i);
+  }
+  const auto existing_result = RoundTrip(existing);
+  EXPECT_EQ(existing_result.page, existing.page);
+  EXPECT_FALSE(existing_result.last_page);
+  ASSERT_EQ(existing_result.existing_players.size(), existing.existing_players.size());
+  for (std::size_t i = 0; i < existing.existing_players.size(); ++i) {
+    EXPECT_EQ(existing_result.existing_players[i].player_id, existing.existing_players[i].player_id);
+    EXPECT_NEAR(existing_result.existing_players[i].position.x, existing.existing_players[i].position.x, Net::kPositionPrecision);
+    EXPECT_EQ(existing_result.existing_players[i].player_name, existing.existing_players[i].player_name);
+  }
+}
+
+TEST(PacketQuantizationTest, DeltaSnapshotEntryRoundTrip) {
+  SnapshotPacket packet;
+  packet.packet_type = Net::PT_SNAPSHOT;
+  packet.sequence = 65535;
+  packet.server_tick = 123456;
+  packet.server_time_ms = 12345600;
+  SnapshotPlayerState& entry = packet.player_states.emplace_back();
+  entry.player_id = 3;
+  entry.baseline_age = 2;
+  entry.changed_fields = PSF_POSITION | PSF_WEAPON_MODE;
+  entry.state = MakePlayerState();
+  packet.player_positions.push_back({4, glm::vec3(-500.0f, 0.0f, 500.0f)});
+
+  const auto result = RoundTrip(packet);
+  ASSERT_EQ(result.player_states.size(), 1u);
+  EXPECT_EQ(result.sequence, packet.sequence);
+  EXPECT_EQ(result.server_tick, packet.server_tick);
+  EXPECT_EQ(result.server_time_ms, packet.server_time_ms);
+  EXPECT_EQ(result.player_states[0].changed_fields, entry.changed_fields);
+  EXPECT_NEAR(result.player_states[0].state.position.x, entry.state.position.x, Net::kPositionPrecision);
+  EXPECT_EQ(result.player_states[0].state.weapon_mode, entry.state.weapon_mode);
+  // Fields outside the mask are not sent.
+  EXPECT_EQ(result.player_states[0].state.mana_points, 0);
+  ASSERT_EQ(result.player_positions.size(), 1u);
+  EXPECT_NEAR(result.player_positions[0].position.z, 500.0f, Net::kPositionPrecision);
+}
+
+TEST(PacketQuantizationTest, SnapshotEntrySizesMatchSerializedSizes) {
+  SnapshotPlayerState entry;
+  entry.player_id = 3;
+  entry.state = MakePlayerState();
+  for (std::uint16_t fields : {std::uint16_t{PSF_POSITION}, std::uint16_t{PSF_POSITION | PSF_NROT | PSF_ANIMATION},
+                               std::uint16_t{PSF_WEAPON_MODE | PSF_HEAD_DIRECTION}, kAllPlayerStateFields}) {
+    entry.baseline_age = 1;
+    entry.changed_fields = fields;
+    EXPECT_EQ(SerializedSize(entry), GetSnapshotPlayerStateSize(entry.baseline_age, fields)) << "fields " << fields;
+  }
+  entry.baseline_age = 0;
+  EXPECT_EQ(SerializedSize(entry), GetSnapshotPlayerStateSize(0, PSF_POSITION));
+
+  EXPECT_EQ(SerializedSize(SnapshotPlayerPosition{4, glm::vec3(1.0f)}), kSnapshotPlayerPositionSize);
+}
+
+TEST(PacketQuantizationTest, ExistingPlayersSizesMatchSerializedSizes) {
+  ExistingPlayersPacket packet;
+  packet.packet_type = Net::PT_EXISTING_PLAYERS;
+  EXPECT_EQ(SerializedSize(packet), kExistingPlayersPacketHeaderSize);
+
+  std::size_t expected_size = kExistingPlayersPacketHeaderSize;
+  for (std::size_t name_length : {0u, 12u, 127u, 128u, 255u}) {
+    ExistingPlayerInfo& info = packet.existing_players.emplace_back();
+    info.position = glm::vec3(-1000.0f, 50.0f, 1000.0f);
+    info.player_name.assign(name_length, 'x');
+    EXPECT_EQ(SerializedSize(info), GetExistingPlayerInfoSize(name_length)) << "name length " << name_length;
+    expected_size += GetExistingPlayerInfoSize(name_length);
+  }
+  EXPECT_EQ(SerializedSize(packet), expected_size);
+}
+
+TEST(PacketQuantizationTest, BytesPerPacketReport) {
+  const std::size_t player_state_update = SerializedSize(PlayerStateUpdatePacket{Net::PT_ACTUAL_STATISTICS, MakePlayerState(), 1u});
+  const std::size_t player_position_update = SerializedSize(PlayerPositionUpdatePacket{Net::PT_MAP_ONLY, glm::vec3(1.0f), 1u});
+
+  RecordProperty("PlayerStateUpdatePacket", static_cast<int>(player_state_update));
+  RecordProperty("PlayerPositionUpdatePacket", static_cast<int>(player_position_update));
+
+  EXPECT_LT(player_state_update, kLegacyPlayerStateUpdateSize);
+  EXPECT_LT(player_position_update, kLegacyPlayerPositionUpdateSize);
+}
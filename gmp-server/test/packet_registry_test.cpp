@@ -0,0 +1,308 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "net_enums.h"
+#include "packet_registry.h"
+#include "packet_views.h"
+#include "packets.h"
+
+namespace {
+
+using namespace Net;
+
+using Buffer = std::vector<std::uint8_t>;
+using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
+using InputAdapter = bitsery::InputBufferAdapter<Buffer::const_iterator>;
+
+template <typename T>
+Buffer Serialize(const T& packet) {
+  Buffer buffer;
+  const auto size = bitsery::quickSerialization<OutputAdapter>(buffer, packet);
+  buffer.resize(size);
+  return buffer;
+}
+
+template <typename T>
+T Deserialize(const Buffer& buffer) {
+  T packet{};
+  auto state = bitsery::quickDeserialization<InputAdapter>({buffer.begin(), buffer.size()}, packet);
+  EXPECT_EQ(state.first, bitsery::ReaderError::NoError);
+  EXPECT_TRUE(state.second);
+  return packet;
+}
+
+template <PacketDirection Direction, PacketID Id>
+std::uint32_t MaxSize() {
+  return PacketDef<Direction, Id>::kTraits.max_size;
+}
+
+struct RecordingHandler {
+  void OnMessage(int& calls, MessagePacket& packet) {
+    ++calls;
+    message = packet.message;
+  }
+
+  void OnAck(int& calls, SnapshotAckPacket& packet) {
+    ++calls;
+    sequence = packet.sequence;
+  }
+
+  void OnVoice(int& calls, RawPacket& packet) {
+    ++calls;
+    voice_size = packet.size;
+  }
+
+  void OnWhisper(int& calls, MessagePacketView& packet) {
+    ++calls;
+    message = packet.message;
+  }
+
+  // Raw packets are checked by the handler.
+  bool OnGameInfo(int& calls, RawPacket& packet) {
+    if (packet.size < 2) {
+      return false;
+    }
+    ++calls;
+    return true;
+  }
+
+  std::string message;
+  std::uint16_t sequence = 0;
+  std::uint32_t voice_size = 0;
+};
+
+using TestDispatcher = PacketDispatcher<PacketDirection::kToServer, RecordingHandler, int&>;
+
+constexpr auto kDispatcher = TestDispatcher::Make(PacketRoute<PT_MSG, &RecordingHandler::OnMessage>{},
+                                                  PacketRoute<PT_SNAPSHOT_ACK, &RecordingHandler::OnAck>{},
+                                                  PacketRoute<PT_VOICE, &RecordingHandler::OnVoice>{},
+                                                  PacketRoute<PT_WHISPER, &RecordingHandler::OnWhisper>{},
+                                                  PacketRoute<PT_GAME_INFO, &RecordingHandler::OnGameInfo>{});
+
+}  // namespace
+
+TEST(PacketRegistryTest, LargestPacketsFitTheirMaxSize) {
+  MessagePacket message;
+  message.packet_type = PT_MSG;
+  message.message = std::string(kMaxMessageLength, 'x');
+  message.sender = 65535;
+  message.recipient = 65535;
+  EXPECT_LE(Serialize(message).size(), (MaxSize<PacketDirection::kToServer, PT_MSG>()));
+  EXPECT_LE(Serialize(message).size(), (MaxSize<PacketDirection::kToClient, PT_SRVMSG>()));
+
+  JoinGamePacket join;
+  join.packet_type = PT_JOIN_GAME;
+  join.player_name = std::string(kMaxPlayerNameLength, 'x');
+  join.player_id = 65535;
+  EXPECT_LE(Serialize(join).size(), (MaxSize<PacketDirection::kToServer, PT_JOIN_GAME>()));
+
+  PlayerStateUpdatePacket update;
+  update.packet_type = PT_ACTUAL_STATISTICS;
+  update.player_id = 65535;
+  EXPECT_LE(Serialize(update).size(), (MaxSize<PacketDirection::kToServer, PT_ACTUAL_STATISTICS>()));
+
+  InitialInfoPacket initial_info;
+  initial_info.packet_type = PT_INITIAL_INFO;
+  initial_info.map_name = std::string(64, 'x');
+  initial_info.player_id = 65535;
+  EXPECT_LE(Serialize(initial_info).size(), (MaxSize<PacketDirection::kToClient, PT_INITIAL_INFO>()));
+
+  DiscordActivityPacket activity;
+  activity.packet_type = PT_DISCORD_ACTIVITY;
+  activity.state = std::string(128, 'x');
+  activity.details = std::string(128, 'x');
+  activity.large_image_key = std::string(32, 'x');
+  activity.large_image_text = std::string(128, 'x');
+  activity.small_image_key = std::string(32, 'x');
+  activity.small_image_text = std::string(128, 'x');
+  EXPECT_LE(Serialize(activity).size(), (MaxSize<PacketDirection::kToClient, PT_DISCORD_ACTIVITY>()));
+
+  ExistingPlayersPacket existing_players;
+  existing_players.packet_type = PT_EXISTING_PLAYERS;
+  existing_players.existing_players.resize(kMaxExistingPlayersPerPage);
+  for (auto& info : existing_players.existing_players) {
+    info.player_name = std::string(kMaxPlayerNameLength, 'x');
+  }
+  EXPECT_LE(Serialize(existing_players).size(), (MaxSize<PacketDirection::kToClient, PT_EXISTING_PLAYERS>()));
+}
+
+TEST(PacketRegistryTest, RoutesToTypedHandler) {
+  RecordingHandler handler;
+  int calls = 0;
+
+  MessagePacket message;
+  message.packet_type = PT_MSG;
+  message.message = "hello";
+  auto buffer = Serialize(message);
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_MSG, buffer.data(), buffer.size(), calls), DispatchResult::kHandled);
+  EXPECT_EQ(handler.message, "hello");
+
+  SnapshotAckPacket ack;
+  ack.packet_type = PT_SNAPSHOT_ACK;
+  ack.sequence = 1234;
+  buffer = Serialize(ack);
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_SNAPSHOT_ACK, buffer.data(), buffer.size(), calls), DispatchResult::kHandled);
+  EXPECT_EQ(handler.sequence, 1234);
+
+  Buffer voice(100, PT_VOICE);
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_VOICE, voice.data(), voice.size(), calls), DispatchResult::kHandled);
+  EXPECT_EQ(handler.voice_size, 100u);
+
+  EXPECT_EQ(calls, 3);
+}
+
+TEST(PacketRegistryTest, RejectsMalformedPackets) {
+  RecordingHandler handler;
+  int calls = 0;
+
+  SnapshotAckPacket ack;
+  ack.packet_type = PT_SNAPSHOT_ACK;
+  auto buffer = Serialize(ack);
+
+  // Cut short.
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_SNAPSHOT_ACK, buffer.data(), buffer.size() - 1, calls), DispatchResult::kMalformed);
+  // Bytes left over.
+  buffer.push_back(0);
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_SNAPSHOT_ACK, buffer.data(), buffer.size(), calls), DispatchResult::kMalformed);
+
+  // Message longer than the text limit.
+  MessagePacket message;
+  message.packet_type = PT_MSG;
+  message.message = std::string(kMaxMessageLength, 'x');
+  buffer = Serialize(message);
+  buffer[1] |= 0x01;
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_MSG, buffer.data(), buffer.size(), calls), DispatchResult::kMalformed);
+
+  // Over the registered max_size.
+  Buffer voice(kMaxVoicePacketSize + 1, PT_VOICE);
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_VOICE, voice.data(), voice.size(), calls), DispatchResult::kMalformed);
+
+  // Rejected by the handler.
+  unsigned char game_info[] = {PT_GAME_INFO, 0};
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_GAME_INFO, game_info, 1, calls), DispatchResult::kMalformed);
+
+  EXPECT_EQ(calls, 0);
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_GAME_INFO, game_info, 2, calls), DispatchResult::kHandled);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(PacketRegistryTest, UnroutedIdsAreUnhandled) {
+  RecordingHandler handler;
+  int calls = 0;
+  Buffer buffer{PT_COMMAND, 0, 0, 0};
+
+  EXPECT_FALSE(kDispatcher.IsRouted(PT_COMMAND));
+  EXPECT_TRUE(kDispatcher.IsRouted(PT_MSG));
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_COMMAND, buffer.data(), buffer.size(), calls), DispatchResult::kUnhandled);
+  EXPECT_EQ(kDispatcher.Dispatch(handler, 255, buffer.data(), buffer.size(), calls), DispatchResult::kUnhandled);
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(PacketRegistryTest, MessageViewReadsTextInPlace) {
+  MessagePacket message;
+  message.packet_type = PT_WHISPER;
+  message.message = std::string(300, 'w');
+  message.recipient = 42;
+  auto buffer = Serialize(message);
+
+  MessagePacketView view;
+  ASSERT_TRUE(DecodeView(buffer.data(), buffer.size(), view));
+  EXPECT_EQ(view.packet_type, PT_WHISPER);
+  EXPECT_EQ(view.message, message.message);
+  EXPECT_EQ(reinterpret_cast<const unsigned char*>(view.message.data()), buffer.data() + 3);
+  EXPECT_FALSE(view.sender.has_value());
+  EXPECT_EQ(view.recipient, message.recipient);
+
+  RecordingHandler handler;
+  int calls = 0;
+  EXPECT_EQ(kDispatcher.Dispatch(handler, PT_WHISPER, buffer.data(), buffer.size(), calls), DispatchResult::kHandled);
+  EXPECT_EQ(handler.message, message.message);
+
+  EXPECT_FALSE(DecodeView(buffer.data(), buffer.size() - 1, view));
+  buffer.push_back(0);
+  EXPECT_FALSE(DecodeView(buffer.data(), buffer.size(), view));
+}
+
+TEST(PacketRegistryTest, RelayedMessageOnlyChangesSender) {
+  MessagePacket message;
+  message.packet_type = PT_WHISPER;
+  message.message = "hello there";
+  message.recipient = 7;
+  const auto received = Serialize(message);
+
+  MessagePacketView view;
+  ASSERT_TRUE(DecodeView(received.data(), received.size(), view));
+  Buffer relayed(1, 0xAB);
+  relayed.resize(WriteMessageWithSender(view, 513, relayed));
+
+  message.sender = 513;
+  EXPECT_EQ(relayed, Serialize(message));
+  const auto decoded = Deserialize<MessagePacket>(relayed);
+  EXPECT_EQ(decoded.message, "hello there");
+  EXPECT_EQ(decoded.sender, NetId{513});
+  EXPECT_EQ(decoded.recipient, NetId{7});
+}
+
+TEST(PacketRegistryTest, JoinGameViewMatchesPacket) {
+  JoinGamePacket join;
+  join.packet_type = PT_JOIN_GAME;
+  join.selected_class = 3;
+  join.position = glm::vec3(1200.0f, -340.0f, 5600.0f);
+  join.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+  join.left_hand_item_instance = 11;
+  join.right_hand_item_instance = 12;
+  join.equipped_armor_instance = 13;
+  join.animation = 14;
+  join.head_model = 1;
+  join.skin_texture = 2;
+  join.face_texture = 3;
+  join.walk_style = 4;
+  join.player_name = "Diego";
+  auto buffer = Serialize(join);
+  const auto expected = Deserialize<JoinGamePacket>(buffer);
+
+  JoinGamePacketView view;
+  ASSERT_TRUE(DecodeView(buffer.data(), buffer.size(), view));
+  EXPECT_EQ(view.selected_class, expected.selected_class);
+  EXPECT_EQ(view.position, expected.position);
+  EXPECT_EQ(view.normal, expected.normal);
+  EXPECT_EQ(view.left_hand_item_instance, expected.left_hand_item_instance);
+  EXPECT_EQ(view.right_hand_item_instance, expected.right_hand_item_instance);
+  EXPECT_EQ(view.equipped_armor_instance, expected.equipped_armor_instance);
+  EXPECT_EQ(view.animation, expected.animation);
+  EXPECT_EQ(view.walk_style, expected.walk_style);
+  EXPECT_EQ(view.player_name, expected.player_name);
+  EXPECT_FALSE(view.player_id.has_value());
+
+  // Name length beyond kMaxPlayerNameLength.
+  const std::size_t name_offset = buffer.size() - join.player_name.size() - 2;
+  buffer[name_offset] = 0x81;
+  EXPECT_FALSE(DecodeView(buffer.data(), buffer.size(), view));
+}
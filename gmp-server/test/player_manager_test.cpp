@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "player_manager.h"
+
+TEST(PlayerManagerTest, DetectsStaleIds) {
+  PlayerManager player_manager;
+  const auto first_id = player_manager.AddPlayer(1, "First");
+  ASSERT_NE(first_id, 0u);
+  ASSERT_TRUE(player_manager.RemovePlayer(first_id));
+
+  // The freed slot is reused under a new generation, the old ID must not resolve to the new player.
+  const auto second_id = player_manager.AddPlayer(2, "Second");
+  EXPECT_NE(second_id, first_id);
+  EXPECT_FALSE(player_manager.HasPlayer(first_id));
+  EXPECT_FALSE(player_manager.GetPlayer(first_id).has_value());
+  EXPECT_FALSE(player_manager.RemovePlayer(first_id));
+  EXPECT_EQ(player_manager.GetInfo(player_manager.GetPlayer(second_id)->get()).name, "Second");
+  EXPECT_EQ(player_manager.GetPlayerByConnection(2)->get().player_id, second_id);
+  EXPECT_FALSE(player_manager.GetPlayerByConnection(1).has_value());
+
+  // The first player's NetId is quarantined, so the second one got a different one.
+  const auto second_net_id = player_manager.GetNetId(second_id);
+  ASSERT_TRUE(second_net_id.has_value());
+  EXPECT_EQ(player_manager.GetPlayerByNetId(*second_net_id)->get().player_id, second_id);
+  EXPECT_FALSE(player_manager.GetPlayerByNetId(*second_net_id - 1).has_value());
+}
+
+TEST(PlayerManagerTest, KeepsLookupsValidWhenPlayersMove) {
+  PlayerManager player_manager;
+  std::vector<PlayerManager::PlayerId> ids;
+  for (Net::ConnectionHandle connection = 1; connection <= 10; ++connection) {
+    ids.push_back(player_manager.AddPlayer(connection, "Player" + std::to_string(connection)));
+  }
+
+  // Removing from the front moves the last players into the gaps.
+  for (std::size_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(player_manager.RemovePlayer(ids[i]));
+  }
+
+  EXPECT_EQ(player_manager.GetPlayerCount(), 5u);
+  std::set<PlayerManager::PlayerId> visited;
+  player_manager.ForEachPlayer([&](const PlayerManager::Player& player) { visited.insert(player.player_id); });
+  EXPECT_EQ(visited, std::set<PlayerManager::PlayerId>(ids.begin() + 5, ids.end()));
+
+  for (std::size_t i = 5; i < ids.size(); ++i) {
+    const Net::ConnectionHandle connection = i + 1;
+    ASSERT_TRUE(player_manager.GetPlayer(ids[i]).has_value());
+    EXPECT_EQ(player_manager.GetPlayer(ids[i])->get().connection, connection);
+    EXPECT_EQ(player_manager.GetPlayerId(connection), ids[i]);
+    EXPECT_EQ(player_manager.GetConnectionHandle(ids[i]), connection);
+  }
+}
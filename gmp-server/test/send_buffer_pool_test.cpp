@@ -0,0 +1,184 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "packets.h"
+#include "player_manager.h"
+#include "send_buffer_pool.h"
+#include "snapshot_builder.h"
+#include "spatial_grid.h"
+
+namespace {
+
+std::atomic<bool> g_count_allocations{false};
+std::atomic<std::uint64_t> g_allocations{0};
+
+void* CountedAllocate(std::size_t size) {
+  if (g_count_allocations.load(std::memory_order_relaxed)) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+// Counts heap allocations made on any thread between construction and Stop.
+class AllocationCounter {
+public:
+  AllocationCounter() {
+    g_allocations = 0;
+    g_count_allocations = true;
+  }
+  ~AllocationCounter() {
+    g_count_allocations = false;
+  }
+
+  std::uint64_t Stop() {
+    g_count_allocations = false;
+    return g_allocations;
+  }
+};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return CountedAllocate(size);
+}
+void* operator new[](std::size_t size) {
+  return CountedAllocate(size);
+}
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+void operator delete[](void* memory) noexcept {
+  std::free(memory);
+}
+void operator delete(void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+void operator delete[](void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+TEST(SendBufferPoolTest, ReusesReleasedBuffers) {
+  SendBufferPool pool;
+  const std::uint8_t* first_data = nullptr;
+  {
+    auto lease = pool.Acquire();
+    first_data = lease.Get().data();
+    EXPECT_EQ(lease.Get().size(), SendBufferPool::kSizeClasses[0]);
+  }
+  {
+    auto lease = pool.Acquire();
+    EXPECT_EQ(lease.Get().data(), first_data);
+  }
+  EXPECT_EQ(pool.GetAllocationCount(), 1u);
+
+  // A larger request skips buffers that are too small.
+  auto lease = pool.Acquire(SendBufferPool::kSizeClasses[1] + 1);
+  EXPECT_GE(lease.Get().size(), SendBufferPool::kSizeClasses[1] + 1);
+  EXPECT_EQ(pool.GetAllocationCount(), 2u);
+}
+
+TEST(SendBufferPoolTest, GrownBuffersAreReusedForLargePackets) {
+  SendBufferPool pool;
+  SnapshotPacket packet;
+  packet.packet_type = Net::PT_SNAPSHOT;
+  packet.player_positions.resize(500);
+
+  std::size_t written_size = 0;
+  {
+    auto [lease, size] = pool.Serialize(packet);
+    written_size = size;
+  }
+  ASSERT_GT(written_size, SendBufferPool::kSizeClasses[0]);
+
+  const std::uint64_t allocations = pool.GetAllocationCount();
+  {
+    auto [lease, size] = pool.Serialize(packet);
+    EXPECT_EQ(size, written_size);
+  }
+  EXPECT_EQ(pool.GetAllocationCount(), allocations);
+}
+
+TEST(SendBufferPoolTest, SteadyStateSnapshotTickDoesNotAllocate) {
+  constexpr int kPlayers = 64;
+  constexpr int kWarmupTicks = 2 * kSnapshotBaselineWindow;
+  constexpr int kMeasuredTicks = 100;
+
+  PlayerManager player_manager;
+  SpatialGrid spatial_grid(5000.0f);
+  for (int i = 0; i < kPlayers; ++i) {
+    auto player_id = player_manager.AddPlayer(static_cast<Net::ConnectionHandle>(i + 1), "Player" + std::to_string(i));
+    auto& player = player_manager.GetPlayer(player_id)->get();
+    player.is_ingame = 1;
+    player.health = 100;
+    // Two rows, so every recipient has players in all LOD bands.
+    player.state.position = glm::vec3(static_cast<float>(i % 32) * 800.0f, 0.0f, static_cast<float>(i / 32) * 20000.0f);
+    spatial_grid.Update(player_id, player.state.position);
+  }
+
+  SnapshotBuilder builder(player_manager, spatial_grid);
+  SnapshotPacket packet;
+  packet.packet_type = Net::PT_SNAPSHOT;
+  std::uint64_t sent_bytes = 0;
+
+  auto run_tick = [&](int tick) {
+    // Some players change every tick, so snapshots mix deltas, keepalives and suppressed states.
+    player_manager.ForEachIngamePlayer([&](PlayerManager::Player& player) {
+      if ((player.player_id + tick) % 3 == 0) {
+        player.state.nrot.x = -player.state.nrot.x + 0.5f;
+        ++player.state_revision;
+      }
+    });
+
+    builder.BeginTick();
+    const auto& recipients = builder.GetRecipients();
+    for (std::size_t recipient_index = 0; recipient_index < recipients.size(); ++recipient_index) {
+      builder.Build(recipient_index, packet);
+      auto [lease, written_size] = SendBufferPool::ForCurrentThread().Serialize(packet);
+      sent_bytes += written_size;
+      builder.Acknowledge(recipients[recipient_index]->player_id, packet.sequence);
+    }
+  };
+
+  for (int tick = 0; tick < kWarmupTicks; ++tick) {
+    run_tick(tick);
+  }
+
+  AllocationCounter counter;
+  for (int tick = kWarmupTicks; tick < kWarmupTicks + kMeasuredTicks; ++tick) {
+    run_tick(tick);
+  }
+  EXPECT_EQ(counter.Stop(), 0u);
+  EXPECT_GT(sent_bytes, 0u);
+}
@@ -0,0 +1,286 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "packets.h"
+#include "player_manager.h"
+#include "snapshot_builder.h"
+#include "spatial_grid.h"
+
+namespace {
+
+using Buffer = std::vector<std::uint8_t>;
+
+// Players on a line 30 units apart, all within the full LOD band of each other.
+class SnapshotBuilderTest : public ::testing::Test {
+protected:
+  void AddPlayers(int count) {
+    for (int i = 0; i < count; ++i) {
+      AddPlayerAt(glm::vec3(static_cast<float>(i) * 30.0f, 0.0f, 0.0f));
+    }
+  }
+
+  void AddPlayerAt(const glm::vec3& position) {
+    const auto connection = static_cast<Net::ConnectionHandle>(player_ids_.size() + 1);
+    auto player_id = player_manager_.AddPlayer(connection, "Player" + std::to_string(player_ids_.size()));
+    auto& player = player_manager_.GetPlayer(player_id)->get();
+    player.is_ingame = 1;
+    player.health = 100;
+    player.state.position = position;
+    spatial_grid_.Update(player_id, player.state.position);
+    player_ids_.push_back(player_id);
+  }
+
+  PlayerManager::Player& GetPlayer(std::size_t index) {
+    return player_manager_.GetPlayer(player_ids_[index])->get();
+  }
+
+  // Builds the snapshot of the first player, who sees everyone else.
+  SnapshotPacket BuildForFirstPlayer(std::size_t byte_budget) {
+    builder_.BeginTick();
+    SnapshotPacket packet;
+    packet.packet_type = Net::PT_SNAPSHOT;
+    const auto& recipients = builder_.GetRecipients();
+    for (std::size_t recipient_index = 0; recipient_index < recipients.size(); ++recipient_index) {
+      if (recipients[recipient_index]->player_id == player_ids_.front()) {
+        builder_.Build(recipient_index, packet, byte_budget);
+      }
+    }
+    return packet;
+  }
+
+  // Every player changes every tick, so nothing is suppressed as unchanged.
+  void ChangeAllPlayers() {
+    player_manager_.ForEachIngamePlayer([](PlayerManager::Player& player) {
+      player.state.animation++;
+      player.state_revision++;
+    });
+  }
+
+  PlayerManager player_manager_;
+  SpatialGrid spatial_grid_{5000.0f};
+  SnapshotBuilder builder_{player_manager_, spatial_grid_};
+  std::vector<PlayerManager::PlayerId> player_ids_;
+};
+
+TEST_F(SnapshotBuilderTest, AcknowledgedStateBecomesDeltaBaseline) {
+  AddPlayers(2);
+
+  ChangeAllPlayers();
+  SnapshotPacket packet = BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget);
+  ASSERT_EQ(packet.player_states.size(), 1u);
+  EXPECT_EQ(packet.player_states[0].baseline_age, 0u);
+  EXPECT_EQ(packet.player_states[0].changed_fields, kAllPlayerStateFields);
+  builder_.Acknowledge(player_ids_.front(), packet.sequence);
+
+  // One snapshot later, only the moved position is sent against the acknowledged state.
+  auto& target = GetPlayer(1);
+  target.state.position.x += 10.0f;
+  target.state_revision++;
+  packet = BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget);
+  ASSERT_EQ(packet.player_states.size(), 1u);
+  EXPECT_EQ(packet.player_states[0].baseline_age, 1u);
+  EXPECT_EQ(packet.player_states[0].changed_fields, PSF_POSITION);
+  EXPECT_EQ(packet.player_states[0].state.position, target.state.position);
+}
+
+TEST_F(SnapshotBuilderTest, FullStateWithoutAcknowledgedBaseline) {
+  AddPlayers(2);
+
+  for (int tick = 0; tick < 3; ++tick) {
+    ChangeAllPlayers();
+    const SnapshotPacket packet = BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget);
+    ASSERT_EQ(packet.player_states.size(), 1u);
+    EXPECT_EQ(packet.player_states[0].baseline_age, 0u);
+    EXPECT_EQ(packet.player_states[0].changed_fields, kAllPlayerStateFields);
+  }
+}
+
+TEST_F(SnapshotBuilderTest, BaselineExpiresAfterWindow) {
+  AddPlayers(2);
+
+  ChangeAllPlayers();
+  builder_.Acknowledge(player_ids_.front(), BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget).sequence);
+
+  // The client keeps kSnapshotBaselineWindow snapshots, so the acknowledged one stays usable until it falls out of that window.
+  for (std::uint16_t age = 1; age <= kSnapshotBaselineWindow; ++age) {
+    ChangeAllPlayers();
+    const SnapshotPacket packet = BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget);
+    ASSERT_EQ(packet.player_states.size(), 1u);
+    if (age < kSnapshotBaselineWindow) {
+      EXPECT_EQ(packet.player_states[0].baseline_age, age);
+      EXPECT_EQ(packet.player_states[0].changed_fields, PSF_ANIMATION);
+    } else {
+      EXPECT_EQ(packet.player_states[0].baseline_age, 0u);
+      EXPECT_EQ(packet.player_states[0].changed_fields, kAllPlayerStateFields);
+    }
+  }
+}
+
+TEST_F(SnapshotBuilderTest, UnchangedAcknowledgedStateIsSuppressedUntilKeepalive) {
+  AddPlayers(2);
+  builder_.SetKeepaliveInterval(4);
+
+  ChangeAllPlayers();
+  builder_.Acknowledge(player_ids_.front(), BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget).sequence);
+
+  // The recipient has the current state, so nothing is sent while the baseline is younger than the keepalive interval.
+  for (std::uint16_t age = 1; age < 4; ++age) {
+    const SnapshotPacket packet = BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget);
+    EXPECT_TRUE(packet.player_states.empty()) << "baseline age " << age;
+    EXPECT_EQ(builder_.GetTickStats().suppressed_states, 1u);
+    EXPECT_EQ(builder_.GetTickStats().sent_states, 0u);
+  }
+
+  // Then it is re-sent as a keepalive, an empty delta against the baseline.
+  const SnapshotPacket packet = BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget);
+  ASSERT_EQ(packet.player_states.size(), 1u);
+  EXPECT_EQ(packet.player_states[0].baseline_age, 4u);
+  EXPECT_EQ(packet.player_states[0].changed_fields, 0u);
+  EXPECT_EQ(builder_.GetTickStats().suppressed_states, 0u);
+}
+
+TEST_F(SnapshotBuilderTest, ChangedStateIsNotSuppressed) {
+  AddPlayers(2);
+  builder_.SetKeepaliveInterval(4);
+
+  ChangeAllPlayers();
+  builder_.Acknowledge(player_ids_.front(), BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget).sequence);
+
+  GetPlayer(1).state_revision++;
+  EXPECT_EQ(BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget).player_states.size(), 1u);
+  EXPECT_EQ(builder_.GetTickStats().suppressed_states, 0u);
+}
+
+TEST_F(SnapshotBuilderTest, BandsAreSentAtTheirIntervals) {
+  SnapshotBuilder::LodSettings lod;
+  lod.full_radius = 100.0f;
+  lod.full_interval = 1;
+  lod.near_radius = 1000.0f;
+  lod.near_interval = 3;
+  lod.far_interval = 7;
+  builder_.SetLodSettings(lod);
+
+  // The recipient at the origin, then one player in the full band, four in the near band and four beyond it.
+  AddPlayerAt(glm::vec3(0.0f));
+  AddPlayerAt(glm::vec3(50.0f, 0.0f, 0.0f));
+  for (int i = 0; i < 4; ++i) {
+    AddPlayerAt(glm::vec3(0.0f, 0.0f, 300.0f + 150.0f * static_cast<float>(i)));
+  }
+  for (int i = 0; i < 4; ++i) {
+    AddPlayerAt(glm::vec3(-2000.0f - 6000.0f * static_cast<float>(i), 0.0f, 0.0f));
+  }
+
+  constexpr std::uint32_t kTicks = 6 * 7;
+  std::unordered_map<NetId, std::uint32_t> state_sends;
+  std::unordered_map<NetId, std::uint32_t> position_sends;
+  // Tick modulo the band interval at which each player was sent.
+  std::unordered_map<NetId, std::set<std::uint32_t>> phases;
+  for (std::uint32_t tick = 0; tick < kTicks; ++tick) {
+    ChangeAllPlayers();
+    const SnapshotPacket packet = BuildForFirstPlayer(SnapshotBuilder::kNoByteBudget);
+    for (const auto& entry : packet.player_states) {
+      state_sends[entry.player_id]++;
+      phases[entry.player_id].insert(tick % lod.near_interval);
+    }
+    for (const auto& entry : packet.player_positions) {
+      position_sends[entry.player_id]++;
+      phases[entry.player_id].insert(tick % lod.far_interval);
+    }
+  }
+
+  const auto net_id = [&](std::size_t index) { return *player_manager_.GetNetId(player_ids_[index]); };
+  EXPECT_EQ(state_sends[net_id(1)], kTicks);
+  std::set<std::uint32_t> near_phases;
+  for (std::size_t index = 2; index < 6; ++index) {
+    EXPECT_EQ(state_sends[net_id(index)], kTicks / lod.near_interval) << "near player " << index;
+    EXPECT_EQ(position_sends[net_id(index)], 0u);
+    ASSERT_EQ(phases[net_id(index)].size(), 1u);
+    near_phases.insert(*phases[net_id(index)].begin());
+  }
+  std::set<std::uint32_t> far_phases;
+  for (std::size_t index = 6; index < 10; ++index) {
+    EXPECT_EQ(position_sends[net_id(index)], kTicks / lod.far_interval) << "far player " << index;
+    EXPECT_EQ(state_sends[net_id(index)], 0u);
+    ASSERT_EQ(phases[net_id(index)].size(), 1u);
+    far_phases.insert(*phases[net_id(index)].begin());
+  }
+  // Each pair has its own phase, so a band's players don't all land on the same tick.
+  EXPECT_GT(near_phases.size(), 1u);
+  EXPECT_GT(far_phases.size(), 1u);
+}
+
+TEST_F(SnapshotBuilderTest, EntriesStayWithinByteBudget) {
+  AddPlayers(40);
+  builder_.SetDeltaCompression(false);
+  constexpr std::size_t kBudget = 10 * GetSnapshotPlayerStateSize(0, kAllPlayerStateFields);
+
+  ChangeAllPlayers();
+  const SnapshotPacket packet = BuildForFirstPlayer(kBudget);
+  EXPECT_EQ(packet.player_states.size(), 10u);
+  EXPECT_EQ(builder_.GetTickStats().deferred_entries, 29u);
+
+  Buffer buffer;
+  const std::size_t written_size = bitsery::quickSerialization<bitsery::OutputBufferAdapter<Buffer>>(buffer, packet);
+  // Packet type, sequence, server tick and time, and the two entry counts.
+  EXPECT_LE(written_size, kBudget + 13);
+}
+
+TEST_F(SnapshotBuilderTest, DeferredPlayersAreSentOnLaterTicks) {
+  AddPlayers(40);
+  builder_.SetDeltaCompression(false);
+  constexpr std::size_t kBudget = 10 * GetSnapshotPlayerStateSize(0, kAllPlayerStateFields);
+
+  // 39 players at 10 per tick. Closer players are preferred, but the starved ones catch up within a few ticks.
+  std::unordered_map<std::uint32_t, int> times_sent;
+  for (int tick = 0; tick < 8; ++tick) {
+    ChangeAllPlayers();
+    for (const auto& entry : BuildForFirstPlayer(kBudget).player_states) {
+      times_sent[entry.player_id]++;
+    }
+  }
+  EXPECT_EQ(times_sent.size(), 39u);
+}
+
+TEST_F(SnapshotBuilderTest, RecentInteractionRaisesPriority) {
+  AddPlayers(40);
+  builder_.SetDeltaCompression(false);
+  constexpr std::size_t kBudget = 5 * GetSnapshotPlayerStateSize(0, kAllPlayerStateFields);
+
+  // The farthest player would otherwise be the last one to get a slot.
+  builder_.NoteInteraction(player_ids_.front(), player_ids_.back());
+  ChangeAllPlayers();
+  const SnapshotPacket packet = BuildForFirstPlayer(kBudget);
+  ASSERT_FALSE(packet.player_states.empty());
+  EXPECT_EQ(packet.player_states.front().player_id, player_manager_.GetNetId(player_ids_.back()));
+}
+
+}  // namespace
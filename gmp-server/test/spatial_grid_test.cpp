@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "spatial_grid.h"
+
+namespace {
+
+constexpr float kCellSize = 100.0f;
+
+std::vector<SpatialGrid::PlayerId> GetNeighbours(const SpatialGrid& grid, const glm::vec3& position) {
+  std::vector<SpatialGrid::PlayerId> neighbours;
+  grid.ForEachNeighbour(position, [&](SpatialGrid::PlayerId player_id) { neighbours.push_back(player_id); });
+  std::sort(neighbours.begin(), neighbours.end());
+  return neighbours;
+}
+
+}  // namespace
+
+TEST(SpatialGridTest, MovesPlayersBetweenCells) {
+  SpatialGrid grid(kCellSize);
+  grid.Update(1, glm::vec3(50.0f, 0.0f, 0.0f));
+  grid.Update(2, glm::vec3(60.0f, 0.0f, 0.0f));
+  // Moving within the cell changes nothing.
+  grid.Update(1, glm::vec3(70.0f, 10.0f, 10.0f));
+  EXPECT_EQ(grid.GetCellCount(), 1u);
+
+  grid.Update(1, glm::vec3(450.0f, 0.0f, 0.0f));
+  EXPECT_EQ(grid.GetPlayerCount(), 2u);
+  EXPECT_EQ(grid.GetCellCount(), 2u);
+  EXPECT_EQ(GetNeighbours(grid, glm::vec3(50.0f, 0.0f, 0.0f)), (std::vector<SpatialGrid::PlayerId>{2}));
+  EXPECT_EQ(GetNeighbours(grid, glm::vec3(450.0f, 0.0f, 0.0f)), (std::vector<SpatialGrid::PlayerId>{1}));
+
+  // The cell player 2 leaves is dropped.
+  grid.Update(2, glm::vec3(460.0f, 0.0f, 0.0f));
+  EXPECT_EQ(grid.GetCellCount(), 1u);
+  EXPECT_EQ(GetNeighbours(grid, glm::vec3(450.0f, 0.0f, 0.0f)), (std::vector<SpatialGrid::PlayerId>{1, 2}));
+}
+
+TEST(SpatialGridTest, RemoveDropsEmptyCells) {
+  SpatialGrid grid(kCellSize);
+  grid.Update(1, glm::vec3(0.0f));
+  grid.Update(2, glm::vec3(10.0f));
+  grid.Update(3, glm::vec3(-1000.0f));
+  EXPECT_EQ(grid.GetCellCount(), 2u);
+
+  EXPECT_TRUE(grid.Remove(3));
+  EXPECT_FALSE(grid.Remove(3));
+  EXPECT_EQ(grid.GetCellCount(), 1u);
+  EXPECT_TRUE(GetNeighbours(grid, glm::vec3(-1000.0f)).empty());
+
+  EXPECT_TRUE(grid.Remove(1));
+  EXPECT_EQ(grid.GetCellCount(), 1u);
+  EXPECT_TRUE(grid.Remove(2));
+  EXPECT_EQ(grid.GetCellCount(), 0u);
+  EXPECT_EQ(grid.GetPlayerCount(), 0u);
+}
+
+TEST(SpatialGridTest, NeighbourQueryCoversAdjacentCellsAcrossZero) {
+  SpatialGrid grid(kCellSize);
+  // Cells along x: -1 and -2 are left of the origin, so -0.5 and -100.5 land in different cells than 0 and 100.
+  grid.Update(1, glm::vec3(-0.5f, 0.0f, 0.0f));
+  grid.Update(2, glm::vec3(0.0f, 0.0f, 0.0f));
+  grid.Update(3, glm::vec3(-100.5f, 0.0f, 0.0f));
+  grid.Update(4, glm::vec3(199.5f, 0.0f, 0.0f));
+  grid.Update(5, glm::vec3(200.0f, 0.0f, 0.0f));
+  // Diagonal neighbour of cell (-1, -1, -1).
+  grid.Update(6, glm::vec3(-150.0f, -150.0f, -150.0f));
+  grid.Update(7, glm::vec3(-250.0f, -50.0f, -50.0f));
+
+  EXPECT_EQ(GetNeighbours(grid, glm::vec3(-0.5f, -0.5f, -0.5f)), (std::vector<SpatialGrid::PlayerId>{1, 2, 3, 6}));
+  EXPECT_EQ(GetNeighbours(grid, glm::vec3(0.0f, 0.0f, 0.0f)), (std::vector<SpatialGrid::PlayerId>{1, 2, 4}));
+  EXPECT_EQ(GetNeighbours(grid, glm::vec3(-100.5f, 0.0f, 0.0f)), (std::vector<SpatialGrid::PlayerId>{1, 3, 7}));
+}
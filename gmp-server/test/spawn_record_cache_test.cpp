@@ -0,0 +1,118 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/bitsery.h>
+#include <bitsery/traits/vector.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "net_enums.h"
+#include "packets.h"
+#include "player_manager.h"
+#include "spawn_record_cache.h"
+
+namespace {
+
+using Buffer = std::vector<std::uint8_t>;
+using OutputAdapter = bitsery::OutputBufferAdapter<Buffer>;
+
+template <typename T>
+Buffer Serialize(const T& value) {
+  Buffer buffer;
+  buffer.resize(bitsery::quickSerialization<OutputAdapter>(buffer, value));
+  return buffer;
+}
+
+ExistingPlayerInfo MakeExistingPlayerInfo(const PlayerManager& player_manager, const PlayerManager::Player& player) {
+  const auto& info = player_manager.GetInfo(player);
+  ExistingPlayerInfo player_packet;
+  player_packet.player_id = player.net_id;
+  player_packet.position = player.state.position;
+  player_packet.left_hand_item_instance = player.state.left_hand_item_instance;
+  player_packet.right_hand_item_instance = player.state.right_hand_item_instance;
+  player_packet.equipped_armor_instance = player.state.equipped_armor_instance;
+  player_packet.head_model = info.head;
+  player_packet.skin_texture = info.skin;
+  player_packet.face_texture = info.body;
+  player_packet.walk_style = info.walkstyle;
+  player_packet.player_name = info.name;
+  return player_packet;
+}
+
+}  // namespace
+
+TEST(SpawnRecordCacheTest, RebuildsOnlyAfterInvalidate) {
+  PlayerManager player_manager;
+  const auto player_id = player_manager.AddPlayer(1, "Lester");
+  auto& player = player_manager.GetPlayer(player_id)->get();
+  player_manager.GetInfo(player).head = 3;
+  player.state.equipped_armor_instance = 42;
+  SpawnRecordCache cache;
+
+  auto record = cache.Get(player, player_manager.GetInfo(player));
+  EXPECT_EQ(Buffer(record.begin(), record.end()), Serialize(MakeExistingPlayerInfo(player_manager, player)));
+
+  // Moving only patches the position.
+  player.state.position = glm::vec3(-1234.5f, 80.0f, 9876.25f);
+  ++player.state_revision;
+  record = cache.Get(player, player_manager.GetInfo(player));
+  EXPECT_EQ(Buffer(record.begin(), record.end()), Serialize(MakeExistingPlayerInfo(player_manager, player)));
+  EXPECT_EQ(cache.GetRebuildCount(), 1u);
+
+  player.state.equipped_armor_instance = 7;
+  player_manager.GetInfo(player).name = "Lester the Novice";
+  cache.Invalidate(player_id);
+  record = cache.Get(player, player_manager.GetInfo(player));
+  EXPECT_EQ(Buffer(record.begin(), record.end()), Serialize(MakeExistingPlayerInfo(player_manager, player)));
+  EXPECT_EQ(cache.GetRebuildCount(), 2u);
+}
+
+TEST(SpawnRecordCacheTest, GatheredPageMatchesSerializedPacket) {
+  PlayerManager player_manager;
+  SpawnRecordCache cache;
+  ExistingPlayersPacket packet;
+  packet.packet_type = Net::PT_EXISTING_PLAYERS;
+  packet.page = 3;
+  packet.last_page = true;
+
+  ExistingPlayersPageHeader header{packet.packet_type, packet.page, packet.last_page, 0};
+  Buffer gathered;
+  for (Net::ConnectionHandle connection = 1; connection <= 5; ++connection) {
+    auto& player = player_manager.GetPlayer(player_manager.AddPlayer(connection, "Player" + std::to_string(connection)))->get();
+    player.state.position = glm::vec3(connection * 100.0f, 0.0f, connection * -50.0f);
+    packet.existing_players.push_back(MakeExistingPlayerInfo(player_manager, player));
+
+    const auto record = cache.Get(player, player_manager.GetInfo(player));
+    gathered.insert(gathered.end(), record.begin(), record.end());
+    ++header.count;
+  }
+
+  Buffer page = Serialize(header);
+  ASSERT_EQ(page.size(), kExistingPlayersPacketHeaderSize);
+  page.insert(page.end(), gathered.begin(), gathered.end());
+  EXPECT_EQ(page, Serialize(packet));
+}
@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "latency_histogram.h"
+#include "spsc_ring.h"
+
+TEST(SpscRingTest, RejectsPushWhenFullAndPopWhenEmpty) {
+  SpscRing<int, 4> ring;
+  int value = 0;
+  EXPECT_FALSE(ring.TryPop(value));
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.TryPush(i));
+  }
+  EXPECT_FALSE(ring.TryPush(4));
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(ring.TryPop(value));
+}
+
+TEST(SpscRingTest, PreservesOrderAcrossThreads) {
+  constexpr std::uint64_t kItems = 100'000;
+  SpscRing<std::uint64_t, 1024> ring;
+
+  std::thread producer([&ring]() {
+    for (std::uint64_t i = 0; i < kItems;) {
+      if (ring.TryPush(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::uint64_t expected = 0;
+  std::uint64_t value = 0;
+  while (expected < kItems) {
+    if (ring.TryPop(value)) {
+      ASSERT_EQ(value, expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_EQ(ring.SizeApprox(), 0u);
+}
+
+TEST(LatencyHistogramTest, PercentilesUsePowerOfTwoBuckets) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.GetPercentileUs(0.5), 0u);
+
+  for (int i = 0; i < 99; ++i) {
+    histogram.Record(std::chrono::microseconds(3));
+  }
+  histogram.Record(std::chrono::milliseconds(5));
+
+  EXPECT_EQ(histogram.GetCount(), 100u);
+  EXPECT_EQ(histogram.GetPercentileUs(0.5), 4u);
+  EXPECT_EQ(histogram.GetPercentileUs(1.0), 8192u);
+
+  histogram.Record(std::chrono::hours(1));
+  EXPECT_EQ(histogram.GetBucketCount(LatencyHistogram::kBucketCount - 1), 1u);
+}
@@ -0,0 +1,113 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "state_history.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+PlayerState MakeState(float x) {
+  PlayerState state;
+  state.position = {x, 0.0f, 0.0f};
+  return state;
+}
+
+}  // namespace
+
+TEST(StateHistoryTest, InterpolatesBetweenRecordedStates) {
+  StateHistory history(4);
+  const auto start = StateHistory::Clock::time_point{} + 10s;
+  for (int i = 0; i < 3; ++i) {
+    history.Record(1, start + i * 100ms, MakeState(i * 100.0f));
+  }
+
+  EXPECT_FLOAT_EQ(history.Rewind(1, start + 150ms)->position.x, 150.0f);
+  EXPECT_FLOAT_EQ(history.Rewind(1, start + 100ms)->position.x, 100.0f);
+  // Outside the recorded range the nearest state is used.
+  EXPECT_FLOAT_EQ(history.Rewind(1, start + 1s)->position.x, 200.0f);
+  EXPECT_FLOAT_EQ(history.Rewind(1, start - 1s)->position.x, 0.0f);
+  EXPECT_FALSE(history.Rewind(2, start).has_value());
+}
+
+TEST(StateHistoryTest, OverwritesOldestStates) {
+  StateHistory history(4);
+  const auto start = StateHistory::Clock::time_point{} + 10s;
+  for (int i = 0; i < 10; ++i) {
+    history.Record(1, start + i * 100ms, MakeState(i * 100.0f));
+  }
+
+  // Only the last four states (600 to 900) are left.
+  EXPECT_FLOAT_EQ(history.Rewind(1, start)->position.x, 600.0f);
+  EXPECT_FLOAT_EQ(history.Rewind(1, start + 650ms)->position.x, 650.0f);
+  EXPECT_FLOAT_EQ(history.Rewind(1, start + 900ms)->position.x, 900.0f);
+}
+
+TEST(StateHistoryTest, ReusesRingsOfRemovedPlayers) {
+  StateHistory history(2);
+  const auto start = StateHistory::Clock::time_point{} + 10s;
+  history.Record(1, start, MakeState(1.0f));
+  history.Record(2, start, MakeState(2.0f));
+  history.Remove(1);
+  EXPECT_FALSE(history.Rewind(1, start).has_value());
+
+  // The new player must not see the removed player's states.
+  history.Record(3, start + 100ms, MakeState(3.0f));
+  EXPECT_FLOAT_EQ(history.Rewind(3, start)->position.x, 3.0f);
+  EXPECT_FLOAT_EQ(history.Rewind(2, start)->position.x, 2.0f);
+}
+
+TEST(StateHistoryTest, ViewTimeIsRoundTripAndTickAgo) {
+  const auto now = StateHistory::Clock::time_point{} + 10s;
+  EXPECT_EQ(StateHistory::GetViewTime(now, 150ms, 100ms, 1000ms), now - 250ms);
+  // Unknown pings count as 0, and the rewind never goes past the configured limit.
+  EXPECT_EQ(StateHistory::GetViewTime(now, -1ms, 100ms, 1000ms), now - 100ms);
+  EXPECT_EQ(StateHistory::GetViewTime(now, 2000ms, 100ms, 1000ms), now - 1000ms);
+}
+
+TEST(StateHistoryTest, HitIsCheckedAgainstTheVictimTheAttackerSaw) {
+  // Recorded every 100 ms tick, the victim running along x at 500 units per second.
+  StateHistory history(12);
+  const auto start = StateHistory::Clock::time_point{} + 10s;
+  for (int i = 0; i <= 10; ++i) {
+    history.Record(2, start + i * 100ms, MakeState(i * 50.0f));
+  }
+  const auto now = start + 1s;
+  constexpr float kMaxDistance = 100.0f;
+
+  // At 150 ms ping the attacker saw the victim at x = 375, while it is at 500 by the time the hit arrives.
+  const auto view_time = StateHistory::GetViewTime(now, 150ms, 100ms, 1000ms);
+  EXPECT_FLOAT_EQ(history.Rewind(2, view_time)->position.x, 375.0f);
+  EXPECT_TRUE(history.IsHitInRange(MakeState(300.0f), 2, MakeState(500.0f), view_time, kMaxDistance));
+  EXPECT_FALSE(history.IsHitInRange(MakeState(250.0f), 2, MakeState(500.0f), view_time, kMaxDistance));
+  // Without the rewind the first hit would have been rejected.
+  EXPECT_FALSE(history.IsHitInRange(MakeState(300.0f), 2, MakeState(500.0f), now, kMaxDistance));
+
+  // Nothing recorded for the victim, its current state is used.
+  EXPECT_TRUE(history.IsHitInRange(MakeState(0.0f), 3, MakeState(50.0f), view_time, kMaxDistance));
+}
@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "tick_scheduler.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+using Clock = TickScheduler::Clock;
+
+// Runs the scheduler on a manual clock. Sleeping jumps straight to the deadline and every tick takes tick_duration.
+class TickSchedulerTest : public ::testing::Test {
+protected:
+  TickScheduler MakeScheduler(const TickScheduler::Settings& settings) {
+    return TickScheduler(settings, TickScheduler::TimeSource{[this] { return now_; }, [this](Clock::time_point time) { now_ = time; }});
+  }
+
+  // Runs until `count` ticks are done and returns when each tick started, relative to the start of the loop.
+  std::vector<std::chrono::milliseconds> RunTicks(TickScheduler& scheduler, std::size_t count) {
+    std::vector<std::chrono::milliseconds> tick_times;
+    std::atomic<bool> running{true};
+    scheduler.Run(running, [] {}, [&] {
+      tick_times.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(now_ - start_));
+      now_ += tick_duration_(tick_times.size());
+      if (tick_times.size() == count) {
+        running.store(false);
+      }
+    });
+    return tick_times;
+  }
+
+  const Clock::time_point start_{Clock::now()};
+  Clock::time_point now_{start_};
+  // Duration of the n-th tick, counted from 1.
+  std::function<Clock::duration(std::size_t)> tick_duration_ = [](std::size_t) { return Clock::duration{30ms}; };
+};
+
+}  // namespace
+
+TEST_F(TickSchedulerTest, TicksStayOnTheirDeadlines) {
+  TickScheduler scheduler = MakeScheduler({.tick_interval = 100ms, .poll_interval = 7ms, .max_catch_up_ticks = 3});
+
+  const auto tick_times = RunTicks(scheduler, 50);
+  for (std::size_t i = 0; i < tick_times.size(); ++i) {
+    EXPECT_EQ(tick_times[i], 100ms * (i + 1)) << "tick " << i;
+  }
+  EXPECT_EQ(scheduler.GetStats().ticks.load(), 50u);
+  EXPECT_EQ(scheduler.GetStats().overruns.load(), 0u);
+  EXPECT_EQ(scheduler.GetStats().max_tick_us.load(), 30000u);
+}
+
+TEST_F(TickSchedulerTest, CatchUpIsBounded) {
+  TickScheduler scheduler = MakeScheduler({.tick_interval = 100ms, .poll_interval = 2ms, .max_catch_up_ticks = 3});
+  // The first tick stalls for 10 intervals.
+  tick_duration_ = [](std::size_t tick) { return tick == 1 ? Clock::duration{1000ms} : Clock::duration{1ms}; };
+
+  const auto tick_times = RunTicks(scheduler, 7);
+  // 9 ticks are overdue after the stall. 3 of them are caught up right away, the rest are dropped and the schedule stays on its grid.
+  const std::vector<std::chrono::milliseconds> expected{100ms, 1100ms, 1101ms, 1102ms, 1103ms, 1200ms, 1300ms};
+  EXPECT_EQ(tick_times, expected);
+  EXPECT_EQ(scheduler.GetStats().skipped_ticks.load(), 6u);
+  EXPECT_EQ(scheduler.GetStats().overruns.load(), 1u);
+}
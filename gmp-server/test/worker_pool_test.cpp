@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2025 Gothic Multiplayer Team.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "worker_pool.h"
+
+TEST(WorkerPoolTest, VisitsEveryIndexOnce) {
+  WorkerPool pool(4);
+  ASSERT_EQ(pool.GetThreadCount(), 4u);
+
+  for (std::size_t count : {0u, 1u, 7u, 1000u}) {
+    std::vector<std::atomic<int>> visits(count);
+    std::atomic<bool> bad_worker_index{false};
+    pool.ParallelFor(count, 3, [&](std::size_t begin, std::size_t end, std::size_t worker_index) {
+      if (worker_index >= pool.GetThreadCount()) {
+        bad_worker_index = true;
+      }
+      for (std::size_t i = begin; i < end; ++i) {
+        visits[i]++;
+      }
+    });
+
+    EXPECT_FALSE(bad_worker_index);
+    for (std::size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(visits[i], 1) << "index " << i << " of " << count;
+    }
+  }
+}
+
+TEST(WorkerPoolTest, RunsInlineWithSingleThread) {
+  WorkerPool pool(1);
+  std::size_t calls = 0;
+  pool.ParallelFor(10, 2, [&](std::size_t begin, std::size_t end, std::size_t worker_index) {
+    EXPECT_EQ(worker_index, 0u);
+    EXPECT_EQ(begin, 0u);
+    EXPECT_EQ(end, 10u);
+    ++calls;
+  });
+  EXPECT_EQ(calls, 1u);
+}
@@ -29,4 +29,133 @@ target("BanListTest")
     add_tests("default")
     set_rundir(os.projectdir())
     -- disable the build by default
-    set_default(false)
\ No newline at end of file
+    set_default(false)
+
+target("PacketQuantizationTest")
+    set_kind("binary")
+    add_files("packet_quantization_test.cpp")
+    add_deps("common")
+    add_packages("glm", "bitsery", "fmt")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("SpscRingTest")
+    set_kind("binary")
+    add_files("spsc_ring_test.cpp")
+    add_deps("common")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("SendBufferPoolTest")
+    set_kind("binary")
+    add_files("send_buffer_pool_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    set_rundir(os.projectdir())
+    -- disable the build by default
+    set_default(false)
+
+target("SnapshotBuilderTest")
+    set_kind("binary")
+    add_files("snapshot_builder_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    set_rundir(os.projectdir())
+    -- disable the build by default
+    set_default(false)
+
+target("WorkerPoolTest")
+    set_kind("binary")
+    add_files("worker_pool_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("DistanceKernelTest")
+    set_kind("binary")
+    add_files("distance_kernel_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("StateHistoryTest")
+    set_kind("binary")
+    add_files("state_history_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("PlayerManagerTest")
+    set_kind("binary")
+    add_files("player_manager_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("NetIdAllocatorTest")
+    set_kind("binary")
+    add_files("net_id_allocator_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("SpawnRecordCacheTest")
+    set_kind("binary")
+    add_files("spawn_record_cache_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("AdmissionQueueTest")
+    set_kind("binary")
+    add_files("admission_queue_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("PacketRegistryTest")
+    set_kind("binary")
+    add_files("packet_registry_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("SpatialGridTest")
+    set_kind("binary")
+    add_files("spatial_grid_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
+
+target("TickSchedulerTest")
+    set_kind("binary")
+    add_files("tick_scheduler_test.cpp")
+    add_deps("Server")
+    add_packages("gtest")
+    add_tests("default")
+    -- disable the build by default
+    set_default(false)
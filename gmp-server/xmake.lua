@@ -47,4 +47,4 @@ target("ServerApp")
     add_installfiles("resources/*")
     add_installfiles("resources/scripts/*", {prefixdir = "scripts"})
 
-includes("test")
\ No newline at end of file
+includes("test", "benchmark", "fuzz")
\ No newline at end of file
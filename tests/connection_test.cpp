@@ -48,6 +48,14 @@ TEST_F(ConnectionTest, MultipleClientsJoin_VerifyPacketsTellingAboutPlayers) {
   FakeClient client1("TestUser", &observer1);
   FakeClient client2("TestUser2", &observer2);
 
+  // TestUser is alone, so its list of existing players is empty.
+  std::promise<void> client1_ingame_promise;
+  std::future<void> client1_ingame_future = client1_ingame_promise.get_future();
+  EXPECT_CALL(observer1, OnExistingPlayersPacket(_)).WillOnce([&client1_ingame_promise](const ExistingPlayersPacket& packet) {
+    EXPECT_TRUE(packet.existing_players.empty());
+    client1_ingame_promise.set_value();
+  });
+
   std::promise<void> client1_joined_promise;
   std::future<void> client1_joined_future = client1_joined_promise.get_future();
 
@@ -67,7 +75,9 @@ TEST_F(ConnectionTest, MultipleClientsJoin_VerifyPacketsTellingAboutPlayers) {
     client2_existing_players_promise.set_value();
   });
 
+  // Joins are admitted in arrival order, so TestUser2 only connects once TestUser is in game.
   ASSERT_TRUE(client1.Connect("127.0.0.1", server.GetPort()));
+  ASSERT_TRUE(client1_ingame_future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
   ASSERT_TRUE(client2.Connect("127.0.0.1", server.GetPort()));
   ASSERT_TRUE(client1_joined_future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
   ASSERT_TRUE(client2_existing_players_future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
@@ -33,6 +33,7 @@ SOFTWARE.
 #include <mutex>
 
 #include "net_enums.h"
+#include "packet_registry.h"
 #include "znet_client.h"
 
 using namespace Net;
@@ -58,11 +59,13 @@ void InitClientNetworkLayer() {
   }
 }
 
-template <typename TContainer = std::vector<std::uint8_t>, typename Packet>
-void SerializeAndSend(NetClient* client, const Packet& packet, Net::PacketPriority priority, Net::PacketReliability reliable) {
+// Sends with the delivery registered for the packet id, like GameClient does.
+template <Net::PacketID Id, typename TContainer = std::vector<std::uint8_t>>
+void SerializeAndSend(NetClient* client, const typename Net::PacketDef<Net::PacketDirection::kToServer, Id>::Type& packet) {
+  constexpr auto kTraits = Net::PacketDef<Net::PacketDirection::kToServer, Id>::kTraits;
   TContainer buffer;
   auto written_size = bitsery::quickSerialization<bitsery::OutputBufferAdapter<TContainer>>(buffer, packet);
-  client->SendPacket(buffer.data(), written_size, reliable, priority);
+  client->SendPacket(buffer.data(), written_size, kTraits.reliability, kTraits.priority, kTraits.channel);
 }
 
 }  // namespace
@@ -94,30 +97,51 @@ bool FakeClient::Connect(const std::string& host, uint16_t port) {
 }
 
 bool FakeClient::HandlePacket(unsigned char* data, std::uint32_t size) {
-  Net::PacketID packet_id = static_cast<Net::PacketID>(data[0]);
+  const auto header = ReadPacketHeader(data, size);
+  if (!header) {
+    return true;
+  }
+  data += header->offset;
+  size -= header->offset;
+
+  const auto packet_id = static_cast<Net::PacketID>(header->id);
   if (packet_id == Net::PacketID::PT_INITIAL_INFO) {
     InitialInfoPacket packet;
-    using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-    auto state = bitsery::quickDeserialization<InputAdapter>({data, size}, packet);
+    if (!DecodePacket<PacketDirection::kToClient, PT_INITIAL_INFO>(data, size, packet)) {
+      SPDLOG_ERROR("[{}] malformed {}", username_, PacketIDToString(packet_id));
+      return true;
+    }
     SPDLOG_DEBUG("[{}] received: {}", username_, packet);
     SentJoinGamePacket();
     return true;
   } else if (packet_id == Net::PacketID::PT_JOIN_GAME) {
     JoinGamePacket packet;
-    using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-    auto state = bitsery::quickDeserialization<InputAdapter>({data, size}, packet);
+    if (!DecodePacket<PacketDirection::kToClient, PT_JOIN_GAME>(data, size, packet)) {
+      SPDLOG_ERROR("[{}] malformed {}", username_, PacketIDToString(packet_id));
+      return true;
+    }
     SPDLOG_DEBUG("[{}] received: {}", username_, packet);
     if (observer_) {
       observer_->OnJoinGamePacket(packet);
     }
     return true;
-  }
-  else if (packet_id == Net::PacketID::PT_EXISTING_PLAYERS) {
-    ExistingPlayersPacket packet;
-    using InputAdapter = bitsery::InputBufferAdapter<unsigned char*>;
-    auto state = bitsery::quickDeserialization<InputAdapter>({data, size}, packet);
-    if (observer_) {
-      observer_->OnExistingPlayersPacket(packet);
+  } else if (packet_id == Net::PacketID::PT_EXISTING_PLAYERS) {
+    ExistingPlayersPacket page;
+    if (!DecodePacket<PacketDirection::kToClient, PT_EXISTING_PLAYERS>(data, size, page)) {
+      SPDLOG_ERROR("[{}] malformed {}", username_, PacketIDToString(packet_id));
+      return true;
+    }
+    // Pages are collected until the last one, so observers see the whole list at once.
+    existing_players_.packet_type = page.packet_type;
+    existing_players_.page = page.page;
+    existing_players_.last_page = page.last_page;
+    existing_players_.existing_players.insert(existing_players_.existing_players.end(), page.existing_players.begin(),
+                                              page.existing_players.end());
+    if (page.last_page) {
+      if (observer_) {
+        observer_->OnExistingPlayersPacket(existing_players_);
+      }
+      existing_players_ = ExistingPlayersPacket{};
     }
     return true;
   }
@@ -131,5 +155,5 @@ void FakeClient::SentJoinGamePacket() {
   packet.player_name = username_;
   packet.position = position_;
   packet.normal = rotation_;
-  SerializeAndSend(client_, packet, IMMEDIATE_PRIORITY, RELIABLE);
+  SerializeAndSend<PT_JOIN_GAME>(client_, packet);
 }
@@ -39,6 +39,7 @@ class FakeClientObserver {
 public:
   virtual ~FakeClientObserver() = default;
 
+  // Called once all pages arrived, with the players of every page.
   virtual void OnExistingPlayersPacket(const ExistingPlayersPacket& packet) = 0;
   virtual void OnJoinGamePacket(const JoinGamePacket& packet) = 0;
 };
@@ -66,6 +67,8 @@ private:
   Net::NetClient* client_;
   std::thread client_thread_;
   std::atomic<bool> running_{false};
+  // Pages received so far, only touched by the client thread.
+  ExistingPlayersPacket existing_players_;
   glm::vec3 position_{0.0f};
   glm::vec3 rotation_{0.0f};
 };
@@ -52,6 +52,7 @@ add_rules("mode.debug", "mode.release", "mode.releasedbg")
 add_requires("spdlog 1.15.1", {configs = {fmt_external = true}})
 -- Pulling in gtest_main doesn't work, due to a runtime conflict MT (static) vs MD (dynamic), so we still have to define it ourselves
 add_requires("gtest 1.16.*", {configs = {main = true}})
+add_requires("benchmark 1.9.*")
 add_requires("fmt 11.0.2",
              "toml11 4.3.*", 
              "lua 5.4.7",